@@ -2,82 +2,348 @@
 #ifndef QUANT1X_STD_BUFFER_H
 #define QUANT1X_STD_BUFFER_H 1
 
+#include "base.h"
+#include "fixed_string.h"
+
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
+#include <xsimd/xsimd.hpp>
 
-class BinaryStream {
-private:
-    std::vector<uint8_t> buffer;
-    size_t offset;
+namespace quant1x::detail {
 
+    // 字节序翻转, 编译器会识别为 bswap 指令
     template <typename T>
-    void push_le(T value) {
-        constexpr size_t size = sizeof(T);
-        ensure_capacity(offset + size);
-        for (size_t i = 0; i < size; ++i) {
-            buffer[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+    constexpr T byteswap(T value) noexcept {
+        static_assert(std::is_integral_v<T>, "Only integral types supported");
+        using U = std::make_unsigned_t<T>;
+        U v = static_cast<U>(value);
+        U r = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            r = static_cast<U>((r << 8) | (v & 0xFF));
+            v = static_cast<U>(v >> 8);
+        }
+        return static_cast<T>(r);
+    }
+
+    template <size_t N>
+    using uint_of_size = std::conditional_t<N == 1, uint8_t,
+                         std::conditional_t<N == 2, uint16_t,
+                         std::conditional_t<N == 4, uint32_t, uint64_t>>>;
+
+    /**
+     * @brief 将n个数值以小端序写入dst
+     * @details 小端主机上整块内存拷贝, 大端主机上逐元素翻转字节序(可被编译器向量化为字节重排指令)
+     */
+    template <typename T>
+    inline void store_le(uint8_t* dst, const T* src, size_t n) noexcept {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic types supported");
+#if ENDIAN_LITTLE
+        std::memcpy(dst, src, n * sizeof(T));
+#else
+        using U = uint_of_size<sizeof(T)>;
+        for (size_t i = 0; i < n; ++i) {
+            U v;
+            std::memcpy(&v, src + i, sizeof(T));
+            v = byteswap(v);
+            std::memcpy(dst + i * sizeof(T), &v, sizeof(T));
+        }
+#endif
+    }
+
+    /**
+     * @brief 从src读取n个小端序数值
+     */
+    template <typename T>
+    inline void load_le(T* dst, const uint8_t* src, size_t n) noexcept {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic types supported");
+#if ENDIAN_LITTLE
+        std::memcpy(dst, src, n * sizeof(T));
+#else
+        using U = uint_of_size<sizeof(T)>;
+        for (size_t i = 0; i < n; ++i) {
+            U v;
+            std::memcpy(&v, src + i * sizeof(T), sizeof(T));
+            v = byteswap(v);
+            std::memcpy(dst + i, &v, sizeof(T));
+        }
+#endif
+    }
+
+    // 计算n个T所占字节数, 溢出时抛出异常
+    template <typename T>
+    inline size_t array_bytes(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::length_error("Array size overflow");
+        }
+        return n * sizeof(T);
+    }
+
+} // namespace quant1x::detail
+
+/**
+ * @brief 变长整数编解码
+ * @details
+ *  - tdx: 通达信格式, 首字节 bit7 为延续位, bit6 为符号位, 低6位为数据; 后续字节 bit7 为延续位, 低7位为数据
+ *  - uleb128/sleb128: 标准 LEB128 无符号/有符号编码
+ *  - zigzag: 有符号数映射为无符号数后按 uleb128 编码
+ *
+ * 所有 decode_* 函数都做边界检查, 返回消耗的字节数, 数据不足或编码超长时返回0, 不抛出异常.
+ */
+namespace quant1x::varint {
+
+    // 64位整数编码后的最大字节数
+    constexpr size_t max_bytes = 10;
+
+    constexpr uint64_t zigzag_encode(int64_t value) noexcept {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    constexpr int64_t zigzag_decode(uint64_t value) noexcept {
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    // 通达信格式编码, out 至少需要 max_bytes 字节, 返回写入的字节数
+    inline size_t encode_tdx(int64_t value, uint8_t* out) noexcept {
+        const bool sign = value < 0;
+        uint64_t mag = sign ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+        uint8_t byte = static_cast<uint8_t>((mag & 0x3F) | (sign ? 0x40 : 0x00));
+        mag >>= 6;
+        size_t n = 0;
+        while (mag != 0) {
+            out[n++] = byte | 0x80;
+            byte = static_cast<uint8_t>(mag & 0x7F);
+            mag >>= 7;
+        }
+        out[n++] = byte;
+        return n;
+    }
+
+    // 已知长度的通达信格式解码, 调用方保证 len 在 [1, max_bytes] 之间
+    inline int64_t decode_tdx_fixed(const uint8_t* p, size_t len) noexcept {
+        uint64_t data = p[0] & 0x3F;
+        for (size_t i = 1, shift = 6; i < len; ++i, shift += 7) {
+            data |= static_cast<uint64_t>(p[i] & 0x7F) << shift;
+        }
+        const uint64_t neg = 0 - static_cast<uint64_t>((p[0] >> 6) & 1);
+        return static_cast<int64_t>((data ^ neg) - neg);
+    }
+
+    // 通达信格式解码
+    inline size_t decode_tdx(const uint8_t* p, size_t n, int64_t& out) noexcept {
+        const size_t limit = std::min(n, max_bytes);
+        for (size_t i = 0; i < limit; ++i) {
+            if ((p[i] & 0x80) == 0) {
+                out = decode_tdx_fixed(p, i + 1);
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    inline size_t encode_uleb128(uint64_t value, uint8_t* out) noexcept {
+        size_t n = 0;
+        while (value >= 0x80) {
+            out[n++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[n++] = static_cast<uint8_t>(value);
+        return n;
+    }
+
+    inline size_t decode_uleb128(const uint8_t* p, size_t n, uint64_t& out) noexcept {
+        const size_t limit = std::min(n, max_bytes);
+        uint64_t result = 0;
+        for (size_t i = 0; i < limit; ++i) {
+            result |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+            if ((p[i] & 0x80) == 0) {
+                out = result;
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    inline size_t encode_sleb128(int64_t value, uint8_t* out) noexcept {
+        size_t n = 0;
+        while (true) {
+            uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+            value >>= 7;
+            if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0)) {
+                out[n++] = byte;
+                return n;
+            }
+            out[n++] = byte | 0x80;
+        }
+    }
+
+    inline size_t decode_sleb128(const uint8_t* p, size_t n, int64_t& out) noexcept {
+        const size_t limit = std::min(n, max_bytes);
+        uint64_t result = 0;
+        for (size_t i = 0; i < limit; ++i) {
+            const size_t shift = 7 * i;
+            result |= static_cast<uint64_t>(p[i] & 0x7F) << shift;
+            if ((p[i] & 0x80) == 0) {
+                if (shift + 7 < 64 && (p[i] & 0x40) != 0) {
+                    result |= ~uint64_t(0) << (shift + 7);
+                }
+                out = static_cast<int64_t>(result);
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    inline size_t encode_zigzag(int64_t value, uint8_t* out) noexcept {
+        return encode_uleb128(zigzag_encode(value), out);
+    }
+
+    inline size_t decode_zigzag(const uint8_t* p, size_t n, int64_t& out) noexcept {
+        uint64_t v = 0;
+        size_t used = decode_uleb128(p, n, v);
+        if (used != 0) {
+            out = zigzag_decode(v);
+        }
+        return used;
+    }
+
+    // 批量解码单字节编码的值, 可被编译器向量化
+    inline void decode_tdx_single(const uint8_t* p, int64_t* out, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t neg = 0 - static_cast<uint64_t>((p[i] >> 6) & 1);
+            out[i] = static_cast<int64_t>((uint64_t(p[i] & 0x3F) ^ neg) - neg);
         }
-        offset += size;
+    }
+
+    /**
+     * @brief 批量解码通达信格式变长整数
+     * @details 每次载入一个 SIMD 宽度的字节块, 用 movemask 取出全部延续位.
+     * 最低的延续位之前的字节都是单字节值(小幅度的价格差最常见), 直接无分支批量展开;
+     * 随后的多字节值走标量解码, 再载入下一个块. 不足一个块的尾部走标量路径.
+     * @param p 输入
+     * @param n 输入字节数
+     * @param out 输出
+     * @param count 期望解码的个数
+     * @param consumed 实际消耗的字节数
+     * @return 成功解码的个数, 小于 count 表示数据不足或编码非法
+     */
+    inline size_t decode_tdx_n(const uint8_t* p, size_t n, int64_t* out, size_t count, size_t& consumed) noexcept {
+        using batch = xsimd::batch<uint8_t>;
+        constexpr size_t width = batch::size;
+        const batch high_bit(uint8_t(0x80));
+        const batch zero(uint8_t(0));
+        size_t pos = 0;
+        size_t k = 0;
+        while (count - k >= width && n - pos >= width) {
+            const auto block = batch::load_unaligned(p + pos);
+            const uint64_t cont = ((block & high_bit) != zero).mask();
+            if (cont == 0) {
+                decode_tdx_single(p + pos, out + k, width);
+                pos += width;
+                k += width;
+                continue;
+            }
+            const size_t run = static_cast<size_t>(std::countr_zero(cont));
+            decode_tdx_single(p + pos, out + k, run);
+            pos += run;
+            k += run;
+            const size_t used = decode_tdx(p + pos, n - pos, out[k]);
+            if (used == 0) {
+                consumed = pos;
+                return k;
+            }
+            pos += used;
+            ++k;
+        }
+        while (k < count) {
+            const size_t used = decode_tdx(p + pos, n - pos, out[k]);
+            if (used == 0) {
+                break;
+            }
+            pos += used;
+            ++k;
+        }
+        consumed = pos;
+        return k;
+    }
+
+} // namespace quant1x::varint
+
+/**
+ * @brief 小端序读取的公共实现
+ * @details 派生类只需要提供 bytes() 和 bytes_size() 两个方法, 即可获得全部 get_* 接口,
+ * BinaryStream 和 BinaryStreamView 共用这一套读取逻辑
+ * @tparam Derived 派生类
+ */
+template <typename Derived>
+class BinaryReader {
+protected:
+    size_t offset = 0;
+
+    BinaryReader() = default;
+    explicit BinaryReader(size_t pos) : offset(pos) {}
+
+    [[nodiscard]] const uint8_t* read_ptr() const {
+        return static_cast<const Derived*>(this)->bytes();
+    }
+
+    [[nodiscard]] size_t read_size() const {
+        return static_cast<const Derived*>(this)->bytes_size();
     }
 
     template <typename T>
     T get_le() {
         constexpr size_t size = sizeof(T);
         check_available(size);
-        T value = 0;
-        for (size_t i = 0; i < size; ++i) {
-            value |= static_cast<T>(buffer[offset + i]) << (i * 8);
-        }
+        T value;
+        quant1x::detail::load_le(&value, read_ptr() + offset, 1);
         offset += size;
         return value;
     }
 
-    void ensure_capacity(size_t required) {
-        if (required > buffer.size()) {
-            buffer.resize(required);
-        }
+    // 当前偏移之后是否至少有 required 个字节; 派生类可以隐藏此函数, 在数据不足时补充数据(如流式解压)
+    bool fill(size_t required) {
+        return required <= read_size() && offset <= read_size() - required;
     }
 
     void check_available(size_t required) {
-        if (offset + required > buffer.size()) {
+        if (!static_cast<Derived*>(this)->fill(required)) {
             throw std::out_of_range("Insufficient data in buffer");
         }
     }
 
-public:
-    BinaryStream() : buffer(), offset(0) {}
-    explicit BinaryStream(const std::vector<uint8_t>& data) : buffer(data), offset(0) {}
-    explicit BinaryStream(const std::vector<char>& data) : buffer(data.begin(), data.end()), offset(0) {}
-
-    template <size_t N>
-    explicit BinaryStream(const uint8_t (&data)[N]) :buffer(std::begin(data), std::end(data)), offset(0) {}
-
-    // 禁用拷贝构造和拷贝赋值
-    BinaryStream(const BinaryStream&) = delete;
-    BinaryStream& operator=(const BinaryStream&) = delete;
-
-    // 析构函数 - 不需要特殊处理，vector会自动清理
-    ~BinaryStream() = default;
+    // 变长整数最长10个字节, 解码前尽量备足, 不足时由解码函数判定截断
+    void fill_varint() {
+        static_cast<Derived*>(this)->fill(quant1x::varint::max_bytes);
+    }
 
-    // 通用数值类型写入
-    template <typename T>
-    void push_arithmetic(T value) {
-        if constexpr (std::is_floating_point_v<T>) {
-            using IntType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
-            IntType int_val{};
-            std::memcpy(&int_val, &value, sizeof(T));
-            push_le(int_val);
-        } else {
-            static_assert(std::is_integral_v<T>, "Only arithmetic types supported");
-            push_le(value);
+    static size_t checked_varint(size_t used) {
+        if (used == 0) {
+            throw std::out_of_range("Malformed or truncated varint");
         }
+        return used;
+    }
+
+    // 返回当前偏移处长度为len的视图, 并移动偏移量
+    std::string_view take_view(size_t len) {
+        check_available(len);
+        std::string_view sv(reinterpret_cast<const char*>(read_ptr() + offset), len);
+        offset += len;
+        return sv;
     }
 
+public:
     // 通用数值类型读取
     template <typename T>
     T get_arithmetic() {
@@ -93,18 +359,6 @@ public:
         }
     }
 
-    // 基础类型写入（自动推导）
-    void push_i8(int8_t value) { push_arithmetic(value); }
-    void push_u8(uint8_t value) { push_arithmetic(value); }
-    void push_i16(int16_t value) { push_arithmetic(value); }
-    void push_u16(uint16_t value) { push_arithmetic(value); }
-    void push_i32(int32_t value) { push_arithmetic(value); }
-    void push_u32(uint32_t value) { push_arithmetic(value); }
-    void push_i64(int64_t value) { push_arithmetic(value); }
-    void push_u64(uint64_t value) { push_arithmetic(value); }
-    void push_float(float value) { push_arithmetic(value); }
-    void push_double(double value) { push_arithmetic(value); }
-
     // 基础类型读取
     int8_t get_i8() { return get_arithmetic<int8_t>(); }
     uint8_t get_u8() { return get_arithmetic<uint8_t>(); }
@@ -117,67 +371,68 @@ public:
     float get_float() { return get_arithmetic<float>(); }
     double get_double() { return get_arithmetic<double>(); }
 
-    // 字节数组写入
+    // 字节数组读取
     template <size_t N>
-    void push_byte_array(const uint8_t (&data)[N]) {
-        ensure_capacity(offset + N);
-        std::memcpy(buffer.data() + offset, data, N);
-        offset += N;
+    void get_byte_array(uint8_t (&output)[N]) {
+        get_byte_array(output, N);
     }
 
     template <size_t N>
-    void push_byte_array(const std::array<uint8_t, N>& data) {
-        push_byte_array(data.data());
+    void get_byte_array(std::array<uint8_t, N>& output) {
+        get_byte_array(output.data(), N);
     }
 
-    void push_byte_array(const uint8_t* data, size_t n) {
-        ensure_capacity(offset + n);
-        std::memcpy(buffer.data() + offset, data, n);
-        offset += n;
+    template <size_t N>
+    std::array<uint8_t, N> get_byte_array() {
+        std::array<uint8_t, N> arr;
+        get_byte_array(arr);
+        return arr;
     }
 
-    // 非字节数组写入（逐元素小端序）
-    template <typename T, size_t N>
-    void push_array(const T (&data)[N]) {
-        for (const auto& elem : data) {
-            push_arithmetic(elem);
-        }
+    void get_byte_array(uint8_t* output, size_t n) {
+        check_available(n);
+        std::memcpy(output, read_ptr() + offset, n);
+        offset += n;
     }
 
-    template <typename T, size_t N>
-    void push_array(const std::array<T, N>& arr) {
-        for (const auto& elem : arr) {
-            push_arithmetic(elem);
-        }
+    // 定长字符串字段, 原样拷入内联存储, 不分配内存
+    template <size_t N>
+    void get_fixed_string(strings::fixed_string<N>& output) {
+        get_byte_array(reinterpret_cast<uint8_t*>(output.data()), N);
     }
 
-    // 字节数组读取
     template <size_t N>
-    void get_byte_array(uint8_t (&output)[N]) {
-        check_available(N);
-        std::memcpy(output, buffer.data() + offset, N);
-        offset += N;
+    strings::fixed_string<N> get_fixed_string() {
+        strings::fixed_string<N> s;
+        get_fixed_string(s);
+        return s;
     }
 
-    template <size_t N>
-    std::array<uint8_t, N> get_byte_array() {
-        std::array<uint8_t, N> arr;
-        get_byte_array(arr);
-        return arr;
+    // 零拷贝读取n个字节, 视图依赖底层缓冲区的生命周期
+    std::span<const uint8_t> get_bytes_view(size_t n) {
+        check_available(n);
+        std::span<const uint8_t> view(read_ptr() + offset, n);
+        offset += n;
+        return view;
     }
 
-    void get_byte_array(uint8_t* output, size_t n) {
+    // 非字节数组批量读取（小端序）, 小端主机上为一次内存拷贝
+    template <typename T>
+    void get_array(std::span<T> output) {
+        const size_t n = quant1x::detail::array_bytes<T>(output.size());
         check_available(n);
-        std::memcpy(output, buffer.data() + offset, n);
+        quant1x::detail::load_le(output.data(), read_ptr() + offset, output.size());
         offset += n;
     }
 
-    // 非字节数组读取（逐元素小端序）
     template <typename T, size_t N>
     void get_array(T (&output)[N]) {
-        for (auto& elem : output) {
-            elem = get_arithmetic<T>();
-        }
+        get_array(std::span<T>(output));
+    }
+
+    template <typename T, size_t N>
+    void get_array(std::array<T, N>& output) {
+        get_array(std::span<T>(output));
     }
 
     template <typename T, size_t N>
@@ -187,71 +442,265 @@ public:
         return arr;
     }
 
+    // 通达信格式变长整数
+    int64_t varint_decode() {
+        int64_t value = 0;
+        fill_varint();
+        offset += checked_varint(quant1x::varint::decode_tdx(read_ptr() + offset, remaining(), value));
+        return value;
+    }
+
+    // 批量解码通达信格式变长整数, 填满 output 为止
+    void varint_decode_n(std::span<int64_t> output) {
+        // 全部成功之前不移动偏移量, 失败时光标保持原位
+        size_t done = 0;
+        size_t used = 0;
+        while (true) {
+            size_t consumed = 0;
+            done += quant1x::varint::decode_tdx_n(read_ptr() + offset + used, remaining() - used, output.data() + done, output.size() - done, consumed);
+            used += consumed;
+            if (done == output.size()) {
+                offset += used;
+                return;
+            }
+            // 剩余字节足够却解不出来, 或者补充不到新数据, 说明格式错误或被截断
+            const size_t left = remaining();
+            if (left - used >= quant1x::varint::max_bytes) {
+                throw std::out_of_range("Malformed or truncated varint");
+            }
+            static_cast<Derived*>(this)->fill(used + quant1x::varint::max_bytes);
+            if (remaining() == left) {
+                throw std::out_of_range("Malformed or truncated varint");
+            }
+        }
+    }
+
+    // 标准 LEB128 无符号变长整数
+    uint64_t get_uleb128() {
+        uint64_t value = 0;
+        fill_varint();
+        offset += checked_varint(quant1x::varint::decode_uleb128(read_ptr() + offset, remaining(), value));
+        return value;
+    }
+
+    // 标准 LEB128 有符号变长整数
+    int64_t get_sleb128() {
+        int64_t value = 0;
+        fill_varint();
+        offset += checked_varint(quant1x::varint::decode_sleb128(read_ptr() + offset, remaining(), value));
+        return value;
+    }
+
+    // zigzag 编码的有符号变长整数
+    int64_t get_zigzag() {
+        int64_t value = 0;
+        fill_varint();
+        offset += checked_varint(quant1x::varint::decode_zigzag(read_ptr() + offset, remaining(), value));
+        return value;
+    }
+
+    // 工具方法
+    [[nodiscard]] size_t position() const { return offset; }
+
+    // 确保至少有n个字节可读, 不抛出异常
+    bool ensure(size_t n) {
+        return static_cast<Derived*>(this)->fill(n);
+    }
+
+    // 剩余可读取的字节数
+    [[nodiscard]] size_t remaining() const {
+        return offset < read_size() ? read_size() - offset : 0;
+    }
+
+    // 移动光标到指定偏移
+    void seek(size_t new_offset) {
+        offset = new_offset;
+    }
+    // 在当前偏移的基础上跳过偏移量
+    void skip(size_t skip_offset) {
+        offset += skip_offset;
+    }
+};
+
+/**
+ * @brief 小端序写入的公共实现
+ * @details 派生类只需要提供 prepare(n): 在写入位置预留n个字节并返回其首地址, 同时移动写入位置,
+ * 即可获得全部 push_* 接口, BinaryStream 和 BinaryStreamWriter 共用这一套写入逻辑
+ * @tparam Derived 派生类
+ */
+template <typename Derived>
+class BinaryWriter {
+protected:
+    BinaryWriter() = default;
+
+    uint8_t* prepare(size_t n) {
+        return static_cast<Derived*>(this)->prepare(n);
+    }
+
+    template <typename T>
+    void push_le(T value) {
+        quant1x::detail::store_le(prepare(sizeof(T)), &value, 1);
+    }
+
+public:
+    // 通用数值类型写入
+    template <typename T>
+    void push_arithmetic(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            using IntType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            IntType int_val{};
+            std::memcpy(&int_val, &value, sizeof(T));
+            push_le(int_val);
+        } else {
+            static_assert(std::is_integral_v<T>, "Only arithmetic types supported");
+            push_le(value);
+        }
+    }
+
+    // 基础类型写入（自动推导）
+    void push_i8(int8_t value) { push_arithmetic(value); }
+    void push_u8(uint8_t value) { push_arithmetic(value); }
+    void push_i16(int16_t value) { push_arithmetic(value); }
+    void push_u16(uint16_t value) { push_arithmetic(value); }
+    void push_i32(int32_t value) { push_arithmetic(value); }
+    void push_u32(uint32_t value) { push_arithmetic(value); }
+    void push_i64(int64_t value) { push_arithmetic(value); }
+    void push_u64(uint64_t value) { push_arithmetic(value); }
+    void push_float(float value) { push_arithmetic(value); }
+    void push_double(double value) { push_arithmetic(value); }
+
+    // 字节数组写入
+    template <size_t N>
+    void push_byte_array(const uint8_t (&data)[N]) {
+        push_byte_array(data, N);
+    }
+
+    template <size_t N>
+    void push_byte_array(const std::array<uint8_t, N>& data) {
+        push_byte_array(data.data(), N);
+    }
+
+    void push_byte_array(const uint8_t* data, size_t n) {
+        if (n != 0) {
+            std::memcpy(prepare(n), data, n);
+        }
+    }
+
+    // 非字节数组批量写入（小端序）, 小端主机上为一次内存拷贝
+    template <typename T>
+    void push_array(std::span<const T> data) {
+        const size_t n = quant1x::detail::array_bytes<T>(data.size());
+        quant1x::detail::store_le(prepare(n), data.data(), data.size());
+    }
+
+    template <typename T, size_t N>
+    void push_array(const T (&data)[N]) {
+        push_array(std::span<const T>(data));
+    }
+
+    template <typename T, size_t N>
+    void push_array(const std::array<T, N>& arr) {
+        push_array(std::span<const T>(arr));
+    }
+
     // 带长度前缀的字符串处理
-    void push_length_prefixed_string(const std::string& str) {
+    void push_length_prefixed_string(std::string_view str) {
         push_arithmetic<uint32_t>(uint32_t(str.size()));
         push_byte_array(reinterpret_cast<const uint8_t*>(str.data()), str.size());
     }
 
-    std::string get_length_prefixed_string() {
-        uint32_t len = get_arithmetic<uint32_t>();
-        check_available(len);
-        std::string str(reinterpret_cast<const char*>(buffer.data() + offset), len);
-        offset += len;
-        return str;
+    // 变长整数写入, 与 varint_decode/get_uleb128/get_sleb128/get_zigzag 对应
+    void push_varint(int64_t value) {
+        uint8_t tmp[quant1x::varint::max_bytes];
+        push_byte_array(tmp, quant1x::varint::encode_tdx(value, tmp));
+    }
+
+    void push_uleb128(uint64_t value) {
+        uint8_t tmp[quant1x::varint::max_bytes];
+        push_byte_array(tmp, quant1x::varint::encode_uleb128(value, tmp));
+    }
+
+    void push_sleb128(int64_t value) {
+        uint8_t tmp[quant1x::varint::max_bytes];
+        push_byte_array(tmp, quant1x::varint::encode_sleb128(value, tmp));
+    }
+
+    void push_zigzag(int64_t value) {
+        uint8_t tmp[quant1x::varint::max_bytes];
+        push_byte_array(tmp, quant1x::varint::encode_zigzag(value, tmp));
+    }
+
+    // 定长字符串字段, 原样写出 N 个字节
+    template <size_t N>
+    void push_fixed_string(const strings::fixed_string<N>& str) {
+        push_byte_array(reinterpret_cast<const uint8_t*>(str.data()), N);
     }
 
     // 原始字符串处理（无长度前缀）
-    void push_string(const std::string& str) {
+    void push_string(std::string_view str) {
         push_byte_array(reinterpret_cast<const uint8_t*>(str.data()), str.size());
     }
+};
 
-//    std::string get_string(size_t len) {
-//        check_available(len);
-//        std::string str(reinterpret_cast<const char*>(buffer.data() + offset), len);
-//        offset += len;
-//        return str;
-//    }
-    std::string get_string(size_t len) {
-        check_available(len); // 确保缓冲区有足够的数据
+class BinaryStream : public BinaryReader<BinaryStream>, public BinaryWriter<BinaryStream> {
+private:
+    friend class BinaryReader<BinaryStream>;
+    friend class BinaryWriter<BinaryStream>;
 
-        const char* start = reinterpret_cast<const char*>(buffer.data() + offset);
-        size_t actual_len = strnlen(start, len); // 查找第一个 '\0' 或最大长度
+    std::vector<uint8_t> buffer;
 
-        std::string str(start, actual_len); // 截断到第一个 '\0'
-        offset += len; // 偏移量始终增加 len
+    [[nodiscard]] const uint8_t* bytes() const { return buffer.data(); }
+    [[nodiscard]] size_t bytes_size() const { return buffer.size(); }
 
-        return str;
+    // 在当前偏移处预留n个字节, 允许 seek 之后覆盖已有数据
+    uint8_t* prepare(size_t n) {
+        ensure_capacity(offset + n);
+        uint8_t* p = buffer.data() + offset;
+        offset += n;
+        return p;
     }
 
-    int64_t varint_decode() {
-        uint8_t *b = buffer.data();
-        int *pos = (int *)&offset;
-        uint8_t byte = b[(*pos)++];
-        bool sign = (byte & 0x40) != 0;
-        int64_t data = byte & 0x3F;
-        int shift = 6;
-
-        while (byte & 0x80) {
-            byte = b[(*pos)++];
-            data |= (int64_t)(byte & 0x7F) << shift;
-            shift += 7;
+    // 按几何级数扩容, 避免逐次 push 触发的反复 realloc
+    void ensure_capacity(size_t required) {
+        if (required > buffer.size()) {
+            if (required > buffer.capacity()) {
+                buffer.reserve(std::max(required, buffer.capacity() * 2));
+            }
+            buffer.resize(required);
         }
-
-        return sign ? -data : data;
     }
 
-    // 工具方法
-    [[nodiscard]] size_t position() const { return offset; }
+public:
+    BinaryStream() : buffer() {}
+    explicit BinaryStream(const std::vector<uint8_t>& data) : buffer(data) {}
+    explicit BinaryStream(const std::vector<char>& data) : buffer(data.begin(), data.end()) {}
 
-    // 移动光标到指定偏移
-    void seek(size_t new_offset) {
-        offset = new_offset;
+    template <size_t N>
+    explicit BinaryStream(const uint8_t (&data)[N]) :buffer(std::begin(data), std::end(data)) {}
+
+    // 禁用拷贝构造和拷贝赋值
+    BinaryStream(const BinaryStream&) = delete;
+    BinaryStream& operator=(const BinaryStream&) = delete;
+
+    // 析构函数 - 不需要特殊处理，vector会自动清理
+    ~BinaryStream() = default;
+
+    // 预分配容量
+    void reserve(size_t n) {
+        buffer.reserve(n);
     }
-    // 在当前偏移的基础上跳过偏移量
-    void skip(size_t skip_offset) {
-        offset += skip_offset;
+
+    std::string get_length_prefixed_string() {
+        uint32_t len = get_arithmetic<uint32_t>();
+        return std::string(take_view(len));
+    }
+
+    std::string get_string(size_t len) {
+        std::string_view sv = take_view(len); // 确保缓冲区有足够的数据, 偏移量始终增加 len
+        size_t actual_len = strnlen(sv.data(), len); // 查找第一个 '\0' 或最大长度
+        return std::string(sv.data(), actual_len); // 截断到第一个 '\0'
     }
+
     [[nodiscard]] const std::vector<uint8_t>& data() const {
         return buffer;
     }
@@ -262,4 +711,243 @@ public:
     }
 };
 
+/**
+ * @brief 非持有型二进制读取视图
+ * @details 直接在外部内存(socket缓冲区、mmap映射区、共享内存等)上解码, 不拷贝数据.
+ * 读取接口与 BinaryStream 保持一致, 字符串类接口返回 std::string_view.
+ * 调用方需保证底层内存在视图使用期间有效.
+ */
+class BinaryStreamView : public BinaryReader<BinaryStreamView> {
+private:
+    friend class BinaryReader<BinaryStreamView>;
+
+    std::span<const uint8_t> view_;
+
+    [[nodiscard]] const uint8_t* bytes() const { return view_.data(); }
+    [[nodiscard]] size_t bytes_size() const { return view_.size(); }
+
+public:
+    BinaryStreamView() = default;
+    explicit BinaryStreamView(std::span<const uint8_t> data) : view_(data) {}
+    BinaryStreamView(const uint8_t* data, size_t n) : view_(data, n) {}
+    BinaryStreamView(const char* data, size_t n) : view_(reinterpret_cast<const uint8_t*>(data), n) {}
+    explicit BinaryStreamView(std::string_view data) : BinaryStreamView(data.data(), data.size()) {}
+    explicit BinaryStreamView(const std::vector<uint8_t>& data) : view_(data) {}
+    explicit BinaryStreamView(const BinaryStream& stream) : view_(stream.data()) {}
+
+    template <size_t N>
+    explicit BinaryStreamView(const uint8_t (&data)[N]) : view_(data, N) {}
+
+    // 带长度前缀的字符串, 返回指向底层内存的视图
+    std::string_view get_length_prefixed_string() {
+        uint32_t len = get_arithmetic<uint32_t>();
+        return take_view(len);
+    }
+
+    // 定长字符串, 截断到第一个 '\0', 偏移量始终增加 len
+    std::string_view get_string(size_t len) {
+        std::string_view sv = take_view(len);
+        return sv.substr(0, strnlen(sv.data(), len));
+    }
+
+    // 从当前偏移切出长度为n的子视图, 用于解析嵌套的数据块
+    BinaryStreamView subview(size_t n) {
+        std::string_view sv = take_view(n);
+        return BinaryStreamView(sv.data(), sv.size());
+    }
+
+    // 剩余未读取的字节
+    [[nodiscard]] std::span<const uint8_t> remaining_bytes() const {
+        return view_.subspan(std::min(offset, view_.size()));
+    }
+
+    [[nodiscard]] std::span<const uint8_t> data() const {
+        return view_;
+    }
+};
+
+namespace quant1x {
+
+    /**
+     * @brief 扩容时不做值初始化的分配器
+     * @details std::vector::resize 默认会把新增的字节清零, 对于马上就要被覆盖的写缓冲区是多余的开销
+     */
+    template <typename T, typename A = std::allocator<T>>
+    class default_init_allocator : public A {
+        using traits = std::allocator_traits<A>;
+
+    public:
+        template <typename U>
+        struct rebind {
+            using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+        };
+
+        using A::A;
+
+        template <typename U>
+        void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            ::new (static_cast<void*>(ptr)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* ptr, Args&&... args) {
+            traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+        }
+    };
+
+    // 未初始化扩容的字节缓冲区
+    using byte_buffer = std::vector<uint8_t, default_init_allocator<uint8_t>>;
+
+    /**
+     * @brief 可复用的字节缓冲区池
+     * @details acquire 取出一个保留了容量的缓冲区, release 清空后放回. 稳态下编码不再产生堆分配.
+     * 超过 max_capacity 的缓冲区不回收, 避免偶发的大报文长期占用内存.
+     */
+    class buffer_pool {
+    private:
+        mutable std::mutex       mutex_;
+        std::vector<byte_buffer> free_;
+        size_t                   max_cached_;
+        size_t                   max_capacity_;
+
+    public:
+        explicit buffer_pool(size_t max_cached = 64, size_t max_capacity = 16 * 1024 * 1024)
+            : max_cached_(max_cached), max_capacity_(max_capacity) {
+            free_.reserve(max_cached_);
+        }
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        // 取出一个缓冲区, 容量至少为 size_hint
+        byte_buffer acquire(size_t size_hint = 0) {
+            byte_buffer buf;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!free_.empty()) {
+                    buf = std::move(free_.back());
+                    free_.pop_back();
+                }
+            }
+            if (buf.capacity() < size_hint) {
+                buf.reserve(size_hint);
+            }
+            return buf;
+        }
+
+        // 归还缓冲区
+        void release(byte_buffer&& buf) {
+            if (buf.capacity() == 0 || buf.capacity() > max_capacity_) {
+                return;
+            }
+            buf.clear();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_.size() < max_cached_) {
+                free_.push_back(std::move(buf));
+            }
+        }
+
+        // 池中缓存的缓冲区个数
+        [[nodiscard]] size_t cached() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return free_.size();
+        }
+    };
+
+} // namespace quant1x
+
+/**
+ * @brief 只写模式的二进制流
+ * @details 写入接口与 BinaryStream 一致, 区别在于:
+ *  - 只追加, 没有读取光标
+ *  - 扩容按几何级数进行, 且新增字节不做清零
+ *  - 可以从 buffer_pool 取得存储, 析构时自动归还
+ */
+class BinaryStreamWriter : public BinaryWriter<BinaryStreamWriter> {
+private:
+    friend class BinaryWriter<BinaryStreamWriter>;
+
+    static constexpr size_t min_growth = 256;
+
+    quant1x::byte_buffer  buffer;
+    quant1x::buffer_pool* pool = nullptr;
+
+    uint8_t* prepare(size_t n) {
+        const size_t old_size = buffer.size();
+        const size_t required = old_size + n;
+        if (required > buffer.capacity()) {
+            buffer.reserve(std::max({required, buffer.capacity() * 2, min_growth}));
+        }
+        buffer.resize(required);
+        return buffer.data() + old_size;
+    }
+
+public:
+    BinaryStreamWriter() = default;
+
+    explicit BinaryStreamWriter(size_t capacity) {
+        buffer.reserve(capacity);
+    }
+
+    // 从缓冲区池获取存储
+    explicit BinaryStreamWriter(quant1x::buffer_pool& buffer_pool, size_t capacity = 0)
+        : buffer(buffer_pool.acquire(capacity)), pool(&buffer_pool) {}
+
+    BinaryStreamWriter(const BinaryStreamWriter&) = delete;
+    BinaryStreamWriter& operator=(const BinaryStreamWriter&) = delete;
+
+    BinaryStreamWriter(BinaryStreamWriter&& other) noexcept
+        : buffer(std::move(other.buffer)), pool(std::exchange(other.pool, nullptr)) {}
+
+    BinaryStreamWriter& operator=(BinaryStreamWriter&& other) noexcept {
+        if (this != &other) {
+            release();
+            buffer = std::move(other.buffer);
+            pool   = std::exchange(other.pool, nullptr);
+        }
+        return *this;
+    }
+
+    ~BinaryStreamWriter() {
+        release();
+    }
+
+    // 预分配容量
+    void reserve(size_t n) {
+        buffer.reserve(n);
+    }
+
+    [[nodiscard]] size_t size() const { return buffer.size(); }
+    [[nodiscard]] size_t capacity() const { return buffer.capacity(); }
+
+    [[nodiscard]] std::span<const uint8_t> data() const {
+        return {buffer.data(), buffer.size()};
+    }
+
+    // 对已写入的数据创建只读视图
+    [[nodiscard]] BinaryStreamView view() const {
+        return BinaryStreamView(buffer.data(), buffer.size());
+    }
+
+    // 清空数据, 保留容量, 用于下一帧的编码
+    void clear() {
+        buffer.clear();
+    }
+
+    // 取走底层存储, 之后不再归还到缓冲区池
+    quant1x::byte_buffer take() {
+        pool = nullptr;
+        return std::move(buffer);
+    }
+
+    // 提前把存储归还到缓冲区池
+    void release() {
+        if (pool != nullptr) {
+            pool->release(std::move(buffer));
+            pool = nullptr;
+        }
+        buffer = quant1x::byte_buffer();
+    }
+};
+
 #endif //QUANT1X_STD_BUFFER_H
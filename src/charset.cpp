@@ -0,0 +1,313 @@
+#include "charset.h"
+
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <iconv.h>
+#include <xsimd/xsimd.hpp>
+
+namespace strings {
+
+    namespace {
+
+        // GBK 双字节: 首字节 0x81~0xFE, 尾字节 0x40~0xFE(不含 0x7F)
+        constexpr size_t gbk_lead_count  = 0xFE - 0x81 + 1;
+        constexpr size_t gbk_trail_count = 0xFE - 0x40 + 1;
+
+        constexpr uint16_t replacement = 0xFFFD;
+
+        struct gbk_tables {
+            std::unique_ptr<uint16_t[]> to_unicode;    // (首字节 - 0x81) * gbk_trail_count + (尾字节 - 0x40), 0 表示无映射
+            std::unique_ptr<uint16_t[]> from_unicode;  // 码点 → GBK 编码(首字节在高位), 0 表示无映射
+        };
+
+        // 逐个双字节编码交给 iconv 转换, 生成双向码表. iconv 不可用时码表为空, 非 ASCII 字符都按无映射处理
+        gbk_tables build_tables() {
+            gbk_tables t{std::make_unique<uint16_t[]>(gbk_lead_count * gbk_trail_count),
+                         std::make_unique<uint16_t[]>(0x10000)};
+            iconv_t cd = iconv_open("UTF-16LE", "GBK");
+            if (cd == reinterpret_cast<iconv_t>(-1)) {
+                return t;
+            }
+            for (unsigned lead = 0x81; lead <= 0xFE; ++lead) {
+                for (unsigned trail = 0x40; trail <= 0xFE; ++trail) {
+                    if (trail == 0x7F) {
+                        continue;
+                    }
+                    char   in[2] = {static_cast<char>(lead), static_cast<char>(trail)};
+                    char   out[4];
+                    char*  in_ptr   = in;
+                    char*  out_ptr  = out;
+                    size_t in_left  = sizeof(in);
+                    size_t out_left = sizeof(out);
+                    if (iconv(cd, &in_ptr, &in_left, &out_ptr, &out_left) == static_cast<size_t>(-1) || in_left != 0 ||
+                        out_left != 2) {
+                        iconv(cd, nullptr, nullptr, nullptr, nullptr);
+                        continue;
+                    }
+                    const auto cp = static_cast<uint16_t>(static_cast<uint8_t>(out[0]) | (static_cast<uint8_t>(out[1]) << 8));
+                    t.to_unicode[(lead - 0x81) * gbk_trail_count + (trail - 0x40)] = cp;
+                    // 多个编码映射到同一码点时保留第一个
+                    if (t.from_unicode[cp] == 0) {
+                        t.from_unicode[cp] = static_cast<uint16_t>((lead << 8) | trail);
+                    }
+                }
+            }
+            iconv_close(cd);
+            return t;
+        }
+
+        const gbk_tables& tables() {
+            static const gbk_tables t = build_tables();
+            return t;
+        }
+
+        // 开头连续的 ASCII 字节数, 每次检查一个 SIMD 宽度
+        size_t ascii_prefix(const uint8_t* p, size_t n) noexcept {
+            using batch = xsimd::batch<uint8_t>;
+            constexpr size_t width = batch::size;
+            size_t i = 0;
+            for (; i + width <= n; i += width) {
+                const uint64_t mask = (batch::load_unaligned(p + i) >= batch(uint8_t(0x80))).mask();
+                if (mask != 0) {
+                    return i + static_cast<size_t>(std::countr_zero(mask));
+                }
+            }
+            while (i < n && p[i] < 0x80) {
+                ++i;
+            }
+            return i;
+        }
+
+        // 双字节 GBK 对应的码点, 非法或无映射时返回0
+        uint16_t gbk_code_point(const uint16_t* to_unicode, const uint8_t* p, size_t n) noexcept {
+            if (n < 2 || p[0] < 0x81 || p[0] > 0xFE || p[1] < 0x40 || p[1] > 0xFE || p[1] == 0x7F) {
+                return 0;
+            }
+            return to_unicode[(p[0] - 0x81) * gbk_trail_count + (p[1] - 0x40)];
+        }
+
+        // 解码一个非 ASCII 的 UTF-8 序列(RFC 3629), 非法时 len 为0
+        uint32_t decode_utf8(const uint8_t* p, size_t n, size_t& len) noexcept {
+            len = 0;
+            const uint8_t c    = p[0];
+            size_t        need = 0;
+            uint32_t      cp   = 0;
+            uint8_t       lo   = 0x80;
+            uint8_t       hi   = 0xBF;
+            if (c < 0xC2) {
+                // 单独的后续字节, 或者两字节的过长编码
+                return 0;
+            } else if (c < 0xE0) {
+                need = 1;
+                cp   = c & 0x1F;
+            } else if (c < 0xF0) {
+                need = 2;
+                cp   = c & 0x0F;
+                lo   = c == 0xE0 ? 0xA0 : lo;  // 过长编码
+                hi   = c == 0xED ? 0x9F : hi;  // 代理区
+            } else if (c < 0xF5) {
+                need = 3;
+                cp   = c & 0x07;
+                lo   = c == 0xF0 ? 0x90 : lo;  // 过长编码
+                hi   = c == 0xF4 ? 0x8F : hi;  // 超过 U+10FFFF
+            } else {
+                return 0;
+            }
+            if (n <= need) {
+                return 0;
+            }
+            for (size_t k = 1; k <= need; ++k) {
+                if (p[k] < lo || p[k] > hi) {
+                    return 0;
+                }
+                lo = 0x80;
+                hi = 0xBF;
+                cp = (cp << 6) | (p[k] & 0x3F);
+            }
+            len = need + 1;
+            return cp;
+        }
+
+        // 写入一个 BMP 码点的 UTF-8 编码, 码点不小于 0x80
+        size_t put_utf8(char* out, uint16_t cp) noexcept {
+            if (cp < 0x800) {
+                out[0] = static_cast<char>(0xC0 | (cp >> 6));
+                out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 2;
+            }
+            out[0] = static_cast<char>(0xE0 | (cp >> 12));
+            out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+
+        /**
+         * Lossy 为 false 时遇到非法序列即停止, bad 为其下标; 为 true 时替换为 U+FFFD 并计数.
+         * Lossy 模式下 out 至少 3n 字节, 否则至少 gbk_to_utf8_capacity(n) 字节
+         */
+        template <bool Lossy>
+        size_t decode_gbk(const uint8_t* in, size_t n, char* out, size_t& bad, size_t& invalid) noexcept {
+            const uint16_t* to_unicode = tables().to_unicode.get();
+            size_t i = 0;
+            size_t o = 0;
+            while (i < n) {
+                const size_t run = ascii_prefix(in + i, n - i);
+                std::memcpy(out + o, in + i, run);
+                i += run;
+                o += run;
+                while (i < n && in[i] >= 0x80) {
+                    const uint16_t cp = gbk_code_point(to_unicode, in + i, n - i);
+                    if (cp == 0) {
+                        if constexpr (!Lossy) {
+                            bad = i;
+                            return o;
+                        }
+                        ++invalid;
+                        o += put_utf8(out + o, replacement);
+                        ++i;
+                        continue;
+                    }
+                    o += put_utf8(out + o, cp);
+                    i += 2;
+                }
+            }
+            return o;
+        }
+
+        // 与 decode_gbk 相同的约定, Lossy 时替换为 '?', out 至少 n 字节
+        template <bool Lossy>
+        size_t encode_gbk(const uint8_t* in, size_t n, char* out, size_t& bad, size_t& invalid) noexcept {
+            const uint16_t* from_unicode = tables().from_unicode.get();
+            size_t i = 0;
+            size_t o = 0;
+            while (i < n) {
+                const size_t run = ascii_prefix(in + i, n - i);
+                std::memcpy(out + o, in + i, run);
+                i += run;
+                o += run;
+                while (i < n && in[i] >= 0x80) {
+                    size_t         len  = 0;
+                    const uint32_t cp   = decode_utf8(in + i, n - i, len);
+                    const uint16_t code = len != 0 && cp < 0x10000 ? from_unicode[cp] : 0;
+                    if (code == 0) {
+                        if constexpr (!Lossy) {
+                            bad = i;
+                            return o;
+                        }
+                        ++invalid;
+                        out[o++] = '?';
+                        i += len != 0 ? len : 1;
+                        continue;
+                    }
+                    out[o++] = static_cast<char>(code >> 8);
+                    out[o++] = static_cast<char>(code & 0xFF);
+                    i += len;
+                }
+            }
+            return o;
+        }
+
+        const uint8_t* bytes(std::string_view str) noexcept {
+            return reinterpret_cast<const uint8_t*>(str.data());
+        }
+
+    }  // namespace
+
+    bool is_ascii(std::string_view str) noexcept {
+        return ascii_prefix(bytes(str), str.size()) == str.size();
+    }
+
+    bool is_utf8(std::string_view str) noexcept {
+        const uint8_t* p = bytes(str);
+        const size_t   n = str.size();
+        size_t         i = 0;
+        while (i < n) {
+            i += ascii_prefix(p + i, n - i);
+            while (i < n && p[i] >= 0x80) {
+                size_t len = 0;
+                decode_utf8(p + i, n - i, len);
+                if (len == 0) {
+                    return false;
+                }
+                i += len;
+            }
+        }
+        return true;
+    }
+
+    size_t gbk_to_utf8(std::string_view gbk, std::span<char> out, std::error_code& ec) noexcept {
+        ec.clear();
+        if (out.size() < gbk_to_utf8_capacity(gbk.size())) {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return 0;
+        }
+        size_t       bad     = std::string_view::npos;
+        size_t       invalid = 0;
+        const size_t n       = decode_gbk<false>(bytes(gbk), gbk.size(), out.data(), bad, invalid);
+        if (bad != std::string_view::npos) {
+            ec = std::make_error_code(std::errc::illegal_byte_sequence);
+            return bad;
+        }
+        return n;
+    }
+
+    size_t utf8_to_gbk(std::string_view utf8, std::span<char> out, std::error_code& ec) noexcept {
+        ec.clear();
+        if (out.size() < utf8_to_gbk_capacity(utf8.size())) {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return 0;
+        }
+        size_t       bad     = std::string_view::npos;
+        size_t       invalid = 0;
+        const size_t n       = encode_gbk<false>(bytes(utf8), utf8.size(), out.data(), bad, invalid);
+        if (bad != std::string_view::npos) {
+            ec = std::make_error_code(std::errc::illegal_byte_sequence);
+            return bad;
+        }
+        return n;
+    }
+
+    std::string gbk_to_utf8(std::string_view gbk) {
+        std::string out(gbk.size() * 3, '\0');
+        size_t      bad     = std::string_view::npos;
+        size_t      invalid = 0;
+        out.resize(decode_gbk<true>(bytes(gbk), gbk.size(), out.data(), bad, invalid));
+        return out;
+    }
+
+    std::string utf8_to_gbk(std::string_view utf8) {
+        std::string out(utf8.size(), '\0');
+        size_t      bad     = std::string_view::npos;
+        size_t      invalid = 0;
+        out.resize(encode_gbk<true>(bytes(utf8), utf8.size(), out.data(), bad, invalid));
+        return out;
+    }
+
+    size_t gbk_to_utf8(std::span<const std::string_view> fields, std::string& chars, std::span<std::string_view> out) {
+        size_t total = 0;
+        for (const auto& field : fields) {
+            total += field.size() * 3;
+        }
+        chars.resize(total);
+        size_t used       = 0;
+        size_t bad_fields = 0;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            size_t       bad     = std::string_view::npos;
+            size_t       invalid = 0;
+            const size_t n       = decode_gbk<true>(bytes(fields[i]), fields[i].size(), chars.data() + used, bad, invalid);
+            // 先只记录长度, 收缩 chars 之后再指向最终的位置
+            out[i] = std::string_view(chars.data(), n);
+            used += n;
+            bad_fields += invalid != 0 ? 1 : 0;
+        }
+        chars.resize(used);
+        const char* p = chars.data();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            out[i] = std::string_view(p, out[i].size());
+            p += out[i].size();
+        }
+        return bad_fields;
+    }
+
+}  // namespace strings
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef QUANT1X_STD_CHARSET_H
+#define QUANT1X_STD_CHARSET_H 1
+
+#include "base.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace strings {
+
+    // 是否全部为 ASCII 字符, SIMD 按块检查最高位
+    bool is_ascii(std::string_view str) noexcept;
+
+    /**
+     * @brief 是否为合法的 UTF-8
+     * @details 拒绝过长编码、代理区码点和超过 U+10FFFF 的码点. 全 ASCII 的块用 SIMD 跳过, 只逐字节检查多字节序列
+     */
+    bool is_utf8(std::string_view str) noexcept;
+
+    // gbk_to_utf8 需要的输出缓冲区大小: ASCII 1字节, 双字节汉字转为3字节
+    constexpr size_t gbk_to_utf8_capacity(size_t n) noexcept {
+        return n + (n + 1) / 2;
+    }
+
+    // utf8_to_gbk 需要的输出缓冲区大小, 不会超过输入长度
+    constexpr size_t utf8_to_gbk_capacity(size_t n) noexcept {
+        return n;
+    }
+
+    /**
+     * @brief GBK 转 UTF-8, 写入调用方提供的缓冲区
+     * @details ASCII 段用 SIMD 整块拷贝, 双字节序列查表. 码表在第一次调用时通过 iconv 生成, 之后不再调用 iconv
+     * @param gbk 输入
+     * @param out 输出, 至少 gbk_to_utf8_capacity(gbk.size()) 字节, 不追加 '\0'
+     * @param ec 遇到非法或无法映射的序列时为 illegal_byte_sequence, out 不够大时为 no_buffer_space
+     * @return 成功时为写入的字节数; 遇到非法序列时为该序列在输入中的下标
+     */
+    size_t gbk_to_utf8(std::string_view gbk, std::span<char> out, std::error_code& ec) noexcept;
+
+    /**
+     * @brief UTF-8 转 GBK, 写入调用方提供的缓冲区
+     * @param utf8 输入
+     * @param out 输出, 至少 utf8_to_gbk_capacity(utf8.size()) 字节, 不追加 '\0'
+     * @param ec 非法的 UTF-8 或 GBK 中没有的字符为 illegal_byte_sequence, out 不够大时为 no_buffer_space
+     * @return 成功时为写入的字节数; 遇到非法序列时为该序列在输入中的下标
+     */
+    size_t utf8_to_gbk(std::string_view utf8, std::span<char> out, std::error_code& ec) noexcept;
+
+    // GBK 转 UTF-8, 非法字节替换为 U+FFFD
+    std::string gbk_to_utf8(std::string_view gbk);
+
+    // UTF-8 转 GBK, 非法序列和 GBK 中没有的字符替换为 '?'
+    std::string utf8_to_gbk(std::string_view utf8);
+
+    /**
+     * @brief 批量把 GBK 字段转为 UTF-8, 例如全市场快照中的证券名称
+     * @details 结果依次写入 chars(先清空, 复用已有容量), out[i] 指向第 i 个字段的结果, 在 chars 下次修改之前有效.
+     * 非法字节替换为 U+FFFD
+     * @param out 至少 fields.size() 个元素
+     * @return 含非法字节的字段个数
+     */
+    size_t gbk_to_utf8(std::span<const std::string_view> fields, std::string& chars, std::span<std::string_view> out);
+
+}  // namespace strings
+
+#endif  // QUANT1X_STD_CHARSET_H
@@ -0,0 +1,225 @@
+#pragma once
+#ifndef QUANT1X_STD_CODEC_H
+#define QUANT1X_STD_CODEC_H 1
+
+#include "buffer.h"
+
+#include <boost/pfr.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * 基于 boost::pfr 的结构体编解码
+ *
+ * 编译期遍历聚合类型的字段, 按声明顺序以小端序写入/读取, 不再需要手写 push_u32/get_double 序列.
+ * 支持的字段类型:
+ *  - 算术类型, bool 按 u8 编码
+ *  - 枚举, 按底层类型编码
+ *  - std::string, u32 长度前缀
+ *  - std::array<T, N>, 定长, 不带长度
+ *  - std::vector<T>, u32 元素个数前缀
+ *  - strings::fixed_string<N>, 定长 N 字节, 原样拷贝
+ *  - 嵌套的聚合类型
+ * 注意: boost::pfr 不支持 C 数组成员, 定长数组请使用 std::array.
+ *
+ * 内存布局与编码布局完全一致(无填充、无 bool、小端主机)的可平凡复制结构体, 整体只做一次内存拷贝.
+ */
+namespace quant1x {
+
+    namespace detail {
+
+        template <typename T>
+        struct is_std_array : std::false_type {};
+        template <typename T, size_t N>
+        struct is_std_array<std::array<T, N>> : std::true_type {};
+
+        template <typename T>
+        struct is_std_vector : std::false_type {};
+        template <typename T, typename A>
+        struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+        template <typename T>
+        struct is_fixed_string : std::false_type {};
+        template <size_t N>
+        struct is_fixed_string<strings::fixed_string<N>> : std::true_type {};
+
+        template <typename T>
+        constexpr bool is_codec_aggregate_v = std::is_class_v<T> && std::is_aggregate_v<T> && !is_std_array<T>::value;
+
+        // 可以批量拷贝的元素类型, bool 的任意字节值并不都是合法的 bool, 排除在外
+        template <typename T>
+        constexpr bool is_bulk_element_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+        template <typename T>
+        constexpr size_t fixed_wire_size();
+
+        template <typename T, size_t... I>
+        constexpr size_t aggregate_wire_size(std::index_sequence<I...>) {
+            constexpr size_t sizes[] = {fixed_wire_size<boost::pfr::tuple_element_t<I, T>>()..., 0};
+            size_t total = 0;
+            for (size_t i = 0; i < sizeof...(I); ++i) {
+                if (sizes[i] == 0) {
+                    return 0;
+                }
+                total += sizes[i];
+            }
+            return total;
+        }
+
+        /**
+         * @brief 定长编码的字节数
+         * @return 0 表示变长或不可批量拷贝
+         */
+        template <typename T>
+        constexpr size_t fixed_wire_size() {
+            if constexpr (is_bulk_element_v<T>) {
+                return sizeof(T);
+            } else if constexpr (std::is_enum_v<T>) {
+                return fixed_wire_size<std::underlying_type_t<T>>();
+            } else if constexpr (is_fixed_string<T>::value) {
+                return T::capacity;
+            } else if constexpr (is_std_array<T>::value) {
+                return std::tuple_size_v<T> * fixed_wire_size<typename T::value_type>();
+            } else if constexpr (is_codec_aggregate_v<T>) {
+                return aggregate_wire_size<T>(std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+            } else {
+                return 0;
+            }
+        }
+
+        // 内存布局即编码布局, 可整体 memcpy
+        template <typename T>
+        constexpr bool is_memcpy_layout_v =
+#if ENDIAN_LITTLE
+            std::is_trivially_copyable_v<T> && fixed_wire_size<T>() == sizeof(T);
+#else
+            false;
+#endif
+
+    }  // namespace detail
+
+    template <typename W, typename T>
+    void encode(BinaryWriter<W>& w, const T& value);
+
+    template <typename R, typename T>
+    void decode(BinaryReader<R>& r, T& value);
+
+    namespace detail {
+
+        template <typename W, typename Seq>
+        void encode_elements(BinaryWriter<W>& w, const Seq& seq) {
+            using E = typename Seq::value_type;
+            if constexpr (is_bulk_element_v<E>) {
+                w.push_array(std::span<const E>(seq.data(), seq.size()));
+            } else if constexpr (is_memcpy_layout_v<E>) {
+                w.push_byte_array(reinterpret_cast<const uint8_t*>(seq.data()), array_bytes<E>(seq.size()));
+            } else {
+                for (const auto& elem : seq) {
+                    encode(w, elem);
+                }
+            }
+        }
+
+        template <typename R, typename E>
+        void decode_elements(BinaryReader<R>& r, E* data, size_t n) {
+            if constexpr (is_bulk_element_v<E>) {
+                r.get_array(std::span<E>(data, n));
+            } else if constexpr (is_memcpy_layout_v<E>) {
+                r.get_byte_array(reinterpret_cast<uint8_t*>(data), array_bytes<E>(n));
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    decode(r, data[i]);
+                }
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 编码任意支持的类型
+     * @param w BinaryStream 或 BinaryStreamWriter
+     * @param value 值
+     */
+    template <typename W, typename T>
+    void encode(BinaryWriter<W>& w, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            w.push_u8(value ? 1 : 0);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            w.push_arithmetic(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            w.push_arithmetic(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            w.push_length_prefixed_string(value);
+        } else if constexpr (detail::is_fixed_string<T>::value) {
+            w.push_fixed_string(value);
+        } else if constexpr (detail::is_memcpy_layout_v<T>) {
+            w.push_byte_array(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+        } else if constexpr (detail::is_std_array<T>::value) {
+            detail::encode_elements(w, value);
+        } else if constexpr (detail::is_std_vector<T>::value) {
+            w.push_u32(static_cast<uint32_t>(value.size()));
+            detail::encode_elements(w, value);
+        } else if constexpr (detail::is_codec_aggregate_v<T>) {
+            boost::pfr::for_each_field(value, [&w](const auto& field) { encode(w, field); });
+        } else {
+            static_assert(sizeof(T) == 0, "Unsupported type for quant1x::encode");
+        }
+    }
+
+    /**
+     * @brief 解码到已有对象
+     * @param r BinaryStream 或 BinaryStreamView
+     * @param value 输出
+     */
+    template <typename R, typename T>
+    void decode(BinaryReader<R>& r, T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            value = r.get_u8() != 0;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            value = r.template get_arithmetic<T>();
+        } else if constexpr (std::is_enum_v<T>) {
+            value = static_cast<T>(r.template get_arithmetic<std::underlying_type_t<T>>());
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            const uint32_t len = r.get_u32();
+            if (!r.ensure(len)) {
+                throw std::out_of_range("Insufficient data in buffer");
+            }
+            value.resize(len);
+            r.get_byte_array(reinterpret_cast<uint8_t*>(value.data()), len);
+        } else if constexpr (detail::is_fixed_string<T>::value) {
+            r.get_fixed_string(value);
+        } else if constexpr (detail::is_memcpy_layout_v<T>) {
+            r.get_byte_array(reinterpret_cast<uint8_t*>(&value), sizeof(T));
+        } else if constexpr (detail::is_std_array<T>::value) {
+            detail::decode_elements(r, value.data(), value.size());
+        } else if constexpr (detail::is_std_vector<T>::value) {
+            const uint32_t n = r.get_u32();
+            // 每个元素至少占1个字节, 提前拦截损坏的长度, 避免巨量分配
+            if (!r.ensure(n)) {
+                throw std::out_of_range("Insufficient data in buffer");
+            }
+            value.resize(n);
+            detail::decode_elements(r, value.data(), value.size());
+        } else if constexpr (detail::is_codec_aggregate_v<T>) {
+            boost::pfr::for_each_field(value, [&r](auto& field) { decode(r, field); });
+        } else {
+            static_assert(sizeof(T) == 0, "Unsupported type for quant1x::decode");
+        }
+    }
+
+    /**
+     * @brief 解码并返回新对象
+     */
+    template <typename T, typename R>
+    T decode(BinaryReader<R>& r) {
+        T value{};
+        decode(r, value);
+        return value;
+    }
+
+}  // namespace quant1x
+
+#endif  // QUANT1X_STD_CODEC_H
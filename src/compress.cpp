@@ -0,0 +1,289 @@
+#include "compress.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <zlib.h>
+
+namespace quant1x {
+
+    namespace {
+
+        class zlib_error_category : public std::error_category {
+        public:
+            [[nodiscard]] const char* name() const noexcept override {
+                return "zlib";
+            }
+
+            [[nodiscard]] std::string message(int code) const override {
+                if (code == Z_NEED_DICT) {
+                    return "need dictionary";
+                }
+                return ::zError(code);
+            }
+        };
+
+        int to_window_bits(zlib_format format, int window_bits) {
+            window_bits = std::clamp(window_bits, 9, 15);
+            switch (format) {
+                case zlib_format::gzip:
+                    return window_bits + 16;
+                case zlib_format::raw:
+                    return -window_bits;
+                case zlib_format::automatic:
+                    return window_bits + 32;
+                default:
+                    return window_bits;
+            }
+        }
+
+        z_stream_s* new_stream() {
+            auto* stream = new z_stream_s;
+            std::memset(stream, 0, sizeof(z_stream_s));
+            return stream;
+        }
+
+        void end_deflate(z_stream_s* stream) {
+            ::deflateEnd(stream);
+            delete stream;
+        }
+
+        void end_inflate(z_stream_s* stream) {
+            ::inflateEnd(stream);
+            delete stream;
+        }
+
+        // 设置输入输出, 单次调用最多处理 UINT_MAX 字节
+        void bind(z_stream_s* stream, std::span<const uint8_t> input, std::span<uint8_t> output) {
+            stream->next_in   = const_cast<Bytef*>(input.data());
+            stream->avail_in  = static_cast<uInt>(std::min<size_t>(input.size(), UINT_MAX));
+            stream->next_out  = output.data();
+            stream->avail_out = static_cast<uInt>(std::min<size_t>(output.size(), UINT_MAX));
+        }
+
+        size_t unbind(z_stream_s* stream, std::span<const uint8_t>& input, std::span<uint8_t> output) {
+            input = input.subspan(static_cast<size_t>(stream->next_in - input.data()));
+            return static_cast<size_t>(stream->next_out - output.data());
+        }
+
+        /**
+         * @brief 把 count 个任务分给 threads 个线程, 调用方线程也参与工作
+         * @param work work(thread_index), 内部自行领取任务
+         */
+        template <typename Work>
+        void run_workers(size_t threads, Work&& work) {
+            std::vector<std::thread> workers;
+            workers.reserve(threads - 1);
+            for (size_t t = 1; t < threads; ++t) {
+                workers.emplace_back(work, t);
+            }
+            work(size_t(0));
+            for (auto& w : workers) {
+                w.join();
+            }
+        }
+
+        size_t resolve_threads(size_t threads, size_t blocks) {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            return std::max<size_t>(1, std::min(threads, blocks));
+        }
+
+        /**
+         * @brief 批量处理的公共逻辑, 每个线程持有一个 coder, 按原子计数领取块
+         * @param coders 每个线程一个, 由调用方线程构造, 构造失败的异常不会落在工作线程里
+         * @param process process(coder, block, writer, ec)
+         */
+        template <typename Coder, typename Process>
+        std::vector<byte_buffer> process_blocks(std::span<const std::span<const uint8_t>> blocks, std::vector<Coder>& coders,
+                                                std::error_code& ec, Process&& process) {
+            ec.clear();
+            std::vector<byte_buffer> results(blocks.size());
+            std::atomic<size_t>      next{0};
+            std::atomic<bool>        failed{false};
+            std::mutex               mutex;
+            run_workers(coders.size(), [&](size_t t) {
+                BinaryStreamWriter writer;
+                std::error_code    local;
+                for (size_t i = next++; i < blocks.size() && !failed.load(std::memory_order_relaxed); i = next++) {
+                    if (!process(coders[t], blocks[i], writer, local)) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!failed.exchange(true)) {
+                            ec = local;
+                        }
+                        return;
+                    }
+                    results[i] = writer.take();
+                }
+            });
+            if (ec) {
+                results.clear();
+            }
+            return results;
+        }
+
+    }  // namespace
+
+    const std::error_category& zlib_category() noexcept {
+        static const zlib_error_category category;
+        return category;
+    }
+
+    deflater::deflater(int level, zlib_format format, int window_bits) : stream_(new_stream(), end_deflate) {
+        if (format == zlib_format::automatic) {
+            format = zlib_format::zlib;
+        }
+        const int rc = ::deflateInit2(stream_.get(), level, Z_DEFLATED, to_window_bits(format, window_bits), 8, Z_DEFAULT_STRATEGY);
+        if (rc != Z_OK) {
+            // 初始化失败时 zlib 没有分配内部状态, deflateEnd 是安全的
+            throw std::system_error(rc, zlib_category(), "deflateInit2");
+        }
+    }
+
+    size_t deflater::process(std::span<const uint8_t>& input, std::span<uint8_t> output, bool finish, std::error_code& ec) {
+        ec.clear();
+        z_stream_s* stream = stream_.get();
+        bind(stream, input, output);
+        // 超过 UINT_MAX 的输入分多次提交, 只有最后一批才能使用 Z_FINISH
+        const int flush = finish && input.size() <= UINT_MAX ? Z_FINISH : Z_NO_FLUSH;
+        const int rc    = ::deflate(stream, flush);
+        const size_t n  = unbind(stream, input, output);
+        if (rc == Z_STREAM_END) {
+            finished_ = true;
+        } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            ec = std::error_code(rc, zlib_category());
+        }
+        return n;
+    }
+
+    void deflater::reset() {
+        ::deflateReset(stream_.get());
+        finished_ = false;
+    }
+
+    inflater::inflater(zlib_format format, int window_bits) : stream_(new_stream(), end_inflate) {
+        const int rc = ::inflateInit2(stream_.get(), to_window_bits(format, window_bits));
+        if (rc != Z_OK) {
+            throw std::system_error(rc, zlib_category(), "inflateInit2");
+        }
+    }
+
+    size_t inflater::process(std::span<const uint8_t>& input, std::span<uint8_t> output, std::error_code& ec) {
+        ec.clear();
+        if (finished_) {
+            return 0;
+        }
+        z_stream_s* stream = stream_.get();
+        bind(stream, input, output);
+        const int rc   = ::inflate(stream, Z_NO_FLUSH);
+        const size_t n = unbind(stream, input, output);
+        if (rc == Z_STREAM_END) {
+            finished_ = true;
+        } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            ec = std::error_code(rc, zlib_category());
+        }
+        return n;
+    }
+
+    void inflater::reset() {
+        ::inflateReset(stream_.get());
+        finished_ = false;
+    }
+
+    inflate_reader::inflate_reader(std::span<const uint8_t> compressed, zlib_format format, size_t window, size_t max_window)
+        : inflater_(format), input_(compressed) {
+        window_.resize(std::max<size_t>(window, varint::max_bytes));
+        max_window_ = std::max(max_window, window_.size());
+    }
+
+    void inflate_reader::reset(std::span<const uint8_t> compressed) {
+        inflater_.reset();
+        input_     = compressed;
+        size_      = 0;
+        discarded_ = 0;
+        offset     = 0;
+        error_.clear();
+    }
+
+    bool inflate_reader::fill(size_t required) {
+        if (offset > size_) {
+            return false;
+        }
+        if (required <= size_ - offset) {
+            return true;
+        }
+        if (error_) {
+            return false;
+        }
+        if (required > max_window_) {
+            // 多半是损坏的长度前缀
+            error_ = std::make_error_code(std::errc::value_too_large);
+            return false;
+        }
+        // 窗口尾部放不下时, 丢弃已读部分, 未读部分移到开头
+        if (required > window_.size() - offset) {
+            const size_t unread = size_ - offset;
+            std::memmove(window_.data(), window_.data() + offset, unread);
+            discarded_ += offset;
+            size_  = unread;
+            offset = 0;
+        }
+        while (size_ - offset < required && !inflater_.finished()) {
+            if (size_ == window_.size()) {
+                // 窗口已满且还有数据要解压时才扩大, 分配量不超过实际解压出的字节数的两倍
+                window_.resize(std::min(window_.size() * 2, max_window_));
+            }
+            const size_t n = inflater_.process(input_, std::span<uint8_t>(window_.data() + size_, window_.size() - size_), error_);
+            size_ += n;
+            if (error_) {
+                return false;
+            }
+            if (n == 0 && input_.empty() && !inflater_.finished()) {
+                // 压缩数据被截断
+                error_ = std::error_code(Z_BUF_ERROR, zlib_category());
+                return false;
+            }
+        }
+        return size_ - offset >= required;
+    }
+
+    std::vector<byte_buffer> compress_blocks(std::span<const std::span<const uint8_t>> blocks, std::error_code& ec, int level,
+                                             zlib_format format, size_t threads) {
+        std::vector<deflater> coders;
+        const size_t          count = resolve_threads(threads, blocks.size());
+        coders.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            coders.emplace_back(level, format);
+        }
+        return process_blocks(blocks, coders, ec, [](deflater& coder, std::span<const uint8_t> block, BinaryStreamWriter& out, std::error_code& e) {
+            out.reserve(block.size() / 2 + 64);
+            return coder.compress(block, out, true, e);
+        });
+    }
+
+    std::vector<byte_buffer> decompress_blocks(std::span<const std::span<const uint8_t>> blocks, std::error_code& ec,
+                                               zlib_format format, size_t threads) {
+        std::vector<inflater> coders;
+        const size_t          count = resolve_threads(threads, blocks.size());
+        coders.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            coders.emplace_back(format);
+        }
+        return process_blocks(blocks, coders, ec, [](inflater& coder, std::span<const uint8_t> block, BinaryStreamWriter& out, std::error_code& e) {
+            out.reserve(block.size() * 4);
+            const bool ok = coder.decompress(block, out, e);
+            if (ok && !coder.finished()) {
+                e = std::error_code(Z_BUF_ERROR, zlib_category());
+            }
+            coder.reset();
+            return ok && !e;
+        });
+    }
+
+}  // namespace quant1x
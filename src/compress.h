@@ -0,0 +1,273 @@
+#pragma once
+#ifndef QUANT1X_STD_COMPRESS_H
+#define QUANT1X_STD_COMPRESS_H 1
+
+#include "buffer.h"
+
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+struct z_stream_s;
+
+/**
+ * zlib 流式压缩/解压
+ *
+ * deflater/inflater 封装可复用的 z_stream, 按块处理输入, 一个流结束后自动 reset, 不必重新初始化.
+ * deflate_writer 是带有限缓冲窗口的 BinaryWriter, push_* 的数据攒满窗口后压缩写入下游;
+ * inflate_reader 是 BinaryReader, 按需把压缩数据解到有限窗口中, 字段直接从窗口中读取, 不需要完整的中间缓冲区.
+ */
+namespace quant1x {
+
+    enum class zlib_format {
+        zlib,       ///< zlib 头(RFC 1950), 通达信的压缩块使用这种格式
+        gzip,       ///< gzip 头(RFC 1952)
+        raw,        ///< 无头的 deflate 数据(RFC 1951)
+        automatic,  ///< 仅用于解压, 自动识别 zlib 或 gzip
+    };
+
+    // zlib 错误码的 error_category
+    const std::error_category& zlib_category() noexcept;
+
+    /**
+     * @brief 可复用的 deflate 压缩器
+     */
+    class deflater {
+    private:
+        std::unique_ptr<z_stream_s, void (*)(z_stream_s*)> stream_;
+        bool finished_ = false;
+
+    public:
+        /**
+         * @param level 压缩级别, -1 为 zlib 默认, 0~9
+         * @param format 输出格式, 不能是 automatic
+         * @param window_bits 窗口大小的对数, 9~15, 越小内存越少
+         */
+        explicit deflater(int level = -1, zlib_format format = zlib_format::zlib, int window_bits = 15);
+
+        deflater(deflater&&) noexcept = default;
+        deflater& operator=(deflater&&) noexcept = default;
+
+        /**
+         * @brief 压缩一段输入
+         * @param input 输入, 返回时前移到未消耗的位置
+         * @param output 输出缓冲区
+         * @param finish 是否结束当前流
+         * @param ec 错误码
+         * @return 写入 output 的字节数
+         */
+        size_t process(std::span<const uint8_t>& input, std::span<uint8_t> output, bool finish, std::error_code& ec);
+
+        // 当前流是否已经结束
+        [[nodiscard]] bool finished() const { return finished_; }
+
+        // 丢弃当前流的状态, 保留已分配的内存
+        void reset();
+
+        /**
+         * @brief 压缩一段输入并追加到 out
+         * @param finish 为 true 时结束当前流并 reset, 之后可以开始下一个流
+         */
+        template <typename W>
+        bool compress(std::span<const uint8_t> input, BinaryWriter<W>& out, bool finish, std::error_code& ec) {
+            uint8_t chunk[16 * 1024];
+            while (true) {
+                const size_t n = process(input, chunk, finish, ec);
+                if (ec) {
+                    return false;
+                }
+                out.push_byte_array(chunk, n);
+                // 未结束的流: 输入耗尽且输出缓冲区没有写满, 说明 zlib 暂时没有更多输出
+                if (finish ? finished_ : (input.empty() && n < sizeof(chunk))) {
+                    break;
+                }
+            }
+            if (finish) {
+                reset();
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief 可复用的 inflate 解压器
+     */
+    class inflater {
+    private:
+        std::unique_ptr<z_stream_s, void (*)(z_stream_s*)> stream_;
+        bool finished_ = false;
+
+    public:
+        /**
+         * @param format 输入格式
+         * @param window_bits 窗口大小的对数, 需要不小于压缩时使用的值
+         */
+        explicit inflater(zlib_format format = zlib_format::automatic, int window_bits = 15);
+
+        inflater(inflater&&) noexcept = default;
+        inflater& operator=(inflater&&) noexcept = default;
+
+        /**
+         * @brief 解压一段输入
+         * @param input 输入, 返回时前移到未消耗的位置
+         * @param output 输出缓冲区
+         * @param ec 错误码
+         * @return 写入 output 的字节数, 流结束后返回0
+         */
+        size_t process(std::span<const uint8_t>& input, std::span<uint8_t> output, std::error_code& ec);
+
+        // 当前流是否已经结束
+        [[nodiscard]] bool finished() const { return finished_; }
+
+        void reset();
+
+        /**
+         * @brief 解压一段输入并追加到 out, 可以分多次输入同一个流
+         * @details 流结束后剩余的输入不会被消耗, finished() 为 true
+         */
+        template <typename W>
+        bool decompress(std::span<const uint8_t> input, BinaryWriter<W>& out, std::error_code& ec) {
+            uint8_t chunk[16 * 1024];
+            while (!finished_) {
+                const size_t n = process(input, chunk, ec);
+                if (ec) {
+                    return false;
+                }
+                out.push_byte_array(chunk, n);
+                if (input.empty() && n < sizeof(chunk)) {
+                    break;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief 压缩写入适配器
+     * @details push_* 的数据先写入有限大小的窗口, 窗口满时压缩写入下游. 必须调用 finish 结束流,
+     * 析构时不会自动结束(无法报告错误).
+     */
+    template <typename W>
+    class deflate_writer : public BinaryWriter<deflate_writer<W>> {
+    private:
+        friend class BinaryWriter<deflate_writer<W>>;
+
+        BinaryWriter<W>* out_;
+        deflater         deflater_;
+        byte_buffer      window_;
+        size_t           size_ = 0;
+        std::error_code  error_;
+
+        uint8_t* prepare(size_t n) {
+            if (size_ + n > window_.size()) {
+                flush_window(false);
+                if (n > window_.size()) {
+                    window_.resize(n);
+                }
+            }
+            uint8_t* p = window_.data() + size_;
+            size_ += n;
+            return p;
+        }
+
+        void flush_window(bool finish) {
+            if (!error_) {
+                deflater_.compress(std::span<const uint8_t>(window_.data(), size_), *out_, finish, error_);
+            }
+            size_ = 0;
+        }
+
+    public:
+        static constexpr size_t default_window = 64 * 1024;
+
+        explicit deflate_writer(BinaryWriter<W>& out, int level = -1, zlib_format format = zlib_format::zlib,
+                                size_t window = default_window)
+            : out_(&out), deflater_(level, format) {
+            window_.resize(std::max<size_t>(window, 64));
+        }
+
+        // 结束当前流, 之后可以继续写入下一个流
+        bool finish(std::error_code& ec) {
+            flush_window(true);
+            ec = std::exchange(error_, {});
+            return !ec;
+        }
+    };
+
+    /**
+     * @brief 解压读取适配器
+     * @details 按需解压到有限大小的窗口, 窗口中已读的部分在下次补充数据时被丢弃.
+     * position/seek 相对于窗口, get_string 等返回的视图在下一次读取之前有效.
+     * 窗口只在已满且解压器仍有输出时按倍数扩大, 不超过 max_window; 单次读取超过 max_window 时
+     * error() 为 value_too_large, 损坏的长度前缀不会导致巨量分配.
+     * 压缩数据损坏或截断时读取函数抛出 std::out_of_range, 具体原因见 error().
+     */
+    class inflate_reader : public BinaryReader<inflate_reader> {
+    private:
+        friend class BinaryReader<inflate_reader>;
+
+        inflater                 inflater_;
+        std::span<const uint8_t> input_;
+        byte_buffer              window_;
+        size_t                   max_window_;
+        size_t                   size_      = 0;  // 窗口中有效的字节数
+        size_t                   discarded_ = 0;  // 已丢弃的字节数
+        std::error_code          error_;
+
+        [[nodiscard]] const uint8_t* bytes() const { return window_.data(); }
+        [[nodiscard]] size_t bytes_size() const { return size_; }
+
+        bool fill(size_t required);
+
+    public:
+        static constexpr size_t default_window     = 64 * 1024;
+        static constexpr size_t default_max_window = 64 * 1024 * 1024;
+
+        explicit inflate_reader(std::span<const uint8_t> compressed, zlib_format format = zlib_format::automatic,
+                                size_t window = default_window, size_t max_window = default_max_window);
+
+        // 复用解压状态和窗口, 读取新的压缩数据
+        void reset(std::span<const uint8_t> compressed);
+
+        // 已经读取的解压后字节数
+        [[nodiscard]] size_t consumed() const { return discarded_ + offset; }
+
+        // 压缩流已结束且窗口中的数据已读完
+        [[nodiscard]] bool eof() {
+            return !fill(1);
+        }
+
+        [[nodiscard]] const std::error_code& error() const { return error_; }
+
+        std::string_view get_string(size_t len) {
+            return take_view(len);
+        }
+
+        std::string_view get_length_prefixed_string() {
+            const uint32_t len = get_u32();
+            return take_view(len);
+        }
+    };
+
+    /**
+     * @brief 多线程批量压缩, 每个块独立成流, 每个线程复用一个压缩器
+     * @param blocks 输入块
+     * @param ec 错误码, 任意一块出错即返回
+     * @param level 压缩级别
+     * @param format 输出格式
+     * @param threads 线程数, 0 表示硬件并发数
+     * @return 与输入一一对应的压缩结果
+     */
+    std::vector<byte_buffer> compress_blocks(std::span<const std::span<const uint8_t>> blocks, std::error_code& ec,
+                                             int level = -1, zlib_format format = zlib_format::zlib, size_t threads = 0);
+
+    /**
+     * @brief 多线程批量解压, 每个线程复用一个解压器
+     */
+    std::vector<byte_buffer> decompress_blocks(std::span<const std::span<const uint8_t>> blocks, std::error_code& ec,
+                                               zlib_format format = zlib_format::automatic, size_t threads = 0);
+
+}  // namespace quant1x
+
+#endif  // QUANT1X_STD_COMPRESS_H
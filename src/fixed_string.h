@@ -0,0 +1,134 @@
+#pragma once
+#ifndef QUANT1X_STD_FIXED_STRING_H
+#define QUANT1X_STD_FIXED_STRING_H 1
+
+#include "base.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace strings {
+
+    /**
+     * @brief 定长内联字符串, 用于报文中的定长字段(名称、代码等)
+     * @details 内存布局就是 char[N], 可平凡拷贝, 可以直接放进打包的结构体里按字节读写.
+     * 长度语义与 strings::from 一致: 截断到第一个 '\0', 没有 '\0' 时长度为 N.
+     * 不分配堆内存, 解码大批量行情快照时不会产生 std::string.
+     */
+    template <size_t N>
+    class fixed_string {
+        static_assert(N > 0, "fixed_string capacity must be positive");
+
+    private:
+        char data_[N];
+
+    public:
+        static constexpr size_t capacity = N;
+
+        constexpr fixed_string() noexcept : data_{} {}
+
+        // 从字符串构造, 超过 N 的部分被截断, 剩余空间补 '\0'
+        constexpr explicit fixed_string(std::string_view str) noexcept : data_{} {
+            const size_t n = std::min(str.size(), N);
+            for (size_t i = 0; i < n; ++i) {
+                data_[i] = str[i];
+            }
+        }
+
+        constexpr explicit fixed_string(const char* str) noexcept : fixed_string(std::string_view(str)) {}
+
+        explicit fixed_string(const std::string& str) noexcept : fixed_string(std::string_view(str)) {}
+
+        // 从报文中的定长字段构造, 原样拷贝 N 个字节
+        static fixed_string from_bytes(const char (&raw)[N]) noexcept {
+            fixed_string s;
+            std::memcpy(s.data_, raw, N);
+            return s;
+        }
+
+        static fixed_string from_bytes(const uint8_t (&raw)[N]) noexcept {
+            fixed_string s;
+            std::memcpy(s.data_, raw, N);
+            return s;
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept {
+            if (std::is_constant_evaluated()) {
+                size_t n = 0;
+                while (n < N && data_[n] != '\0') {
+                    ++n;
+                }
+                return n;
+            }
+            return strnlen(data_, N);
+        }
+
+        [[nodiscard]] constexpr size_t length() const noexcept { return size(); }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return data_[0] == '\0'; }
+
+        // 原始的 N 个字节, 不保证以 '\0' 结尾
+        [[nodiscard]] constexpr const char* data() const noexcept { return data_; }
+
+        constexpr char* data() noexcept { return data_; }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept { return {data_, size()}; }
+
+        constexpr operator std::string_view() const noexcept { return view(); }
+
+        [[nodiscard]] std::string str() const { return std::string(view()); }
+
+        constexpr char operator[](size_t i) const noexcept { return data_[i]; }
+
+        // 清空, 所有字节置 '\0'
+        constexpr void clear() noexcept {
+            std::fill(data_, data_ + N, '\0');
+        }
+
+        constexpr fixed_string& operator=(std::string_view str) noexcept {
+            return *this = fixed_string(str);
+        }
+
+        // 按截断后的内容比较, '\0' 之后的字节不参与
+        friend constexpr bool operator==(const fixed_string& a, const fixed_string& b) noexcept {
+            return a.view() == b.view();
+        }
+
+        friend constexpr bool operator==(const fixed_string& a, std::string_view b) noexcept {
+            return a.view() == b;
+        }
+
+        friend constexpr auto operator<=>(const fixed_string& a, const fixed_string& b) noexcept {
+            return a.view() <=> b.view();
+        }
+
+        friend constexpr auto operator<=>(const fixed_string& a, std::string_view b) noexcept {
+            return a.view() <=> b;
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<fixed_string<8>>);
+    static_assert(sizeof(fixed_string<8>) == 8);
+
+}  // namespace strings
+
+template <size_t N>
+struct std::hash<strings::fixed_string<N>> {
+    size_t operator()(const strings::fixed_string<N>& s) const noexcept {
+        return std::hash<std::string_view>{}(s.view());
+    }
+};
+
+template <size_t N>
+struct fmt::formatter<strings::fixed_string<N>> : fmt::formatter<std::string_view> {
+    auto format(const strings::fixed_string<N>& s, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(s.view(), ctx);
+    }
+};
+
+#endif  // QUANT1X_STD_FIXED_STRING_H
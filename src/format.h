@@ -9,6 +9,9 @@
 #include <type_traits>
 #include <cstddef>
 
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
 // 检测方法是否存在 ---
 template <typename T, typename = void>
 struct has_to_string : std::false_type {};
@@ -57,4 +60,98 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& vec) {
     return os;
 }
 
+// =============================================================================
+// fmt 适配
+// =============================================================================
+
+// 为类型单独实现 fmt::formatter 时特化为 true, 按字符串方法适配的通用 formatter 不再参与
+template <typename T>
+struct has_custom_formatter : std::false_type {};
+
+template <typename T>
+constexpr bool has_string_method_v = has_to_string<T>::value || has_toString<T>::value || has_ToString<T>::value;
+
+namespace quant1x::detail {
+
+    // 按 outputWithPriority 的优先级取得字符串
+    template <typename T>
+    decltype(auto) string_method(const T& value) {
+        if constexpr (has_to_string<T>::value) {
+            return value.to_string();
+        } else if constexpr (has_toString<T>::value) {
+            return value.toString();
+        } else {
+            return value.ToString();
+        }
+    }
+
+    // 写出单个元素: 字符串方法优先, 其次 fmt, 都没有时回退到 <<
+    template <typename T, typename Out>
+    Out format_element(Out out, const T& value) {
+        if constexpr (has_string_method_v<T> && !has_custom_formatter<T>::value) {
+            const auto& str = string_method(value);
+            return std::copy(str.begin(), str.end(), out);
+        } else if constexpr (fmt::is_formattable<T>::value) {
+            return fmt::format_to(out, "{}", value);
+        } else {
+            std::ostringstream oss;
+            oss << value;
+            const std::string str = oss.str();
+            return std::copy(str.begin(), str.end(), out);
+        }
+    }
+
+}  // namespace quant1x::detail
+
+/**
+ * @brief 带 to_string/toString/ToString 方法的类型, 按 outputWithPriority 的优先级格式化
+ * @details 支持字符串的宽度、对齐等格式说明
+ */
+template <typename T>
+struct fmt::formatter<T, char,
+                      std::enable_if_t<has_string_method_v<T> && !has_custom_formatter<T>::value &&
+                                       !fmt::is_range<T, char>::value>> : fmt::formatter<std::string_view> {
+    auto format(const T& value, format_context& ctx) const {
+        const auto& str = quant1x::detail::string_method(value);
+        return fmt::formatter<std::string_view>::format(std::string_view(str), ctx);
+    }
+};
+
+// std::vector 与 operator<< 的输出保持一致: [a, b], 字符串不加引号, 不走 fmt/ranges 的序列格式
+template <typename T>
+struct fmt::range_format_kind<std::vector<T>, char> : std::integral_constant<fmt::range_format, fmt::range_format::disabled> {};
+
+template <typename T>
+struct fmt::formatter<std::vector<T>, char> {
+    constexpr auto parse(format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    auto format(const std::vector<T>& vec, format_context& ctx) const {
+        auto out = ctx.out();
+        *out++ = '[';
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            if (i != 0) {
+                *out++ = ',';
+                *out++ = ' ';
+            }
+            out = quant1x::detail::format_element(out, vec[i]);
+        }
+        *out++ = ']';
+        return out;
+    }
+};
+
+namespace quant1x {
+
+    /**
+     * @brief 格式化追加到可复用的缓冲区, 缓冲区容量在多次调用之间保留
+     */
+    template <typename... Args>
+    void format_into(fmt::memory_buffer& out, fmt::format_string<Args...> fmt, Args&&... args) {
+        fmt::format_to(fmt::appender(out), fmt, std::forward<Args>(args)...);
+    }
+
+}  // namespace quant1x
+
 #endif // QUANT1X_STD_FORMAT_H
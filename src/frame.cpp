@@ -0,0 +1,221 @@
+#include "frame.h"
+
+#include <cerrno>
+#include <climits>
+
+#if OS_IS_WINDOWS
+#include <io.h>
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace quant1x {
+
+    namespace {
+
+#if OS_IS_WINDOWS
+        struct io_slice {
+            const uint8_t* base;
+            size_t         len;
+        };
+#else
+        using io_slice = struct iovec;
+
+#if defined(IOV_MAX)
+        constexpr size_t max_iov = IOV_MAX;
+#else
+        constexpr size_t max_iov = 1024;
+#endif
+#endif
+
+        inline void set_slice(io_slice& s, const uint8_t* p, size_t n) {
+#if OS_IS_WINDOWS
+            s.base = p;
+            s.len  = n;
+#else
+            s.iov_base = const_cast<uint8_t*>(p);
+            s.iov_len  = n;
+#endif
+        }
+
+        inline size_t slice_len(const io_slice& s) {
+#if OS_IS_WINDOWS
+            return s.len;
+#else
+            return s.iov_len;
+#endif
+        }
+
+        inline void advance_slice(io_slice& s, size_t n) {
+#if OS_IS_WINDOWS
+            s.base += n;
+            s.len -= n;
+#else
+            s.iov_base = static_cast<uint8_t*>(s.iov_base) + n;
+            s.iov_len -= n;
+#endif
+        }
+
+        /**
+         * @brief 循环调用 write_fn 直到全部写完, write_fn 一次最多提交一批 slice, 返回写入字节数, 小于0表示出错
+         */
+        template <typename WriteFn>
+        size_t write_all(std::vector<io_slice>& slices, std::error_code& ec, WriteFn&& write_fn) {
+            ec.clear();
+            size_t written = 0;
+            size_t first   = 0;
+            while (first < slices.size()) {
+                const int64_t n = write_fn(slices.data() + first, slices.size() - first);
+                if (n < 0) {
+#if !OS_IS_WINDOWS
+                    if (errno == EINTR) {
+                        continue;
+                    }
+#endif
+                    return written;
+                }
+                size_t left = static_cast<size_t>(n);
+                written += left;
+                while (first < slices.size() && left >= slice_len(slices[first])) {
+                    left -= slice_len(slices[first]);
+                    ++first;
+                }
+                if (left > 0) {
+                    advance_slice(slices[first], left);
+                }
+                if (n == 0 && first < slices.size()) {
+                    ec = std::make_error_code(std::errc::io_error);
+                    return written;
+                }
+            }
+            return written;
+        }
+
+        /**
+         * @brief 把报文各段转为 slice, 跳过前 offset 个字节
+         */
+        template <typename Segments>
+        std::vector<io_slice> make_slices(const Segments& segments, const uint8_t* inline_base, size_t offset) {
+            std::vector<io_slice> slices;
+            slices.reserve(segments.size());
+            for (const auto& seg : segments) {
+                if (offset >= seg.size) {
+                    offset -= seg.size;
+                    continue;
+                }
+                const uint8_t* p = seg.data != nullptr ? seg.data : inline_base + seg.offset;
+                slices.emplace_back();
+                set_slice(slices.back(), p + offset, seg.size - offset);
+                offset = 0;
+            }
+            return slices;
+        }
+
+    }  // namespace
+
+    frame_builder::frame_builder(size_t inline_capacity, size_t copy_threshold) : copy_threshold_(copy_threshold) {
+        inline_.reserve(inline_capacity);
+        segments_.reserve(8);
+    }
+
+    uint8_t* frame_builder::prepare(size_t n) {
+        if (segments_.empty() || segments_.back().data != nullptr) {
+            segments_.push_back({nullptr, inline_.size(), 0});
+        }
+        const size_t old_size = inline_.size();
+        const size_t required = old_size + n;
+        if (required > inline_.capacity()) {
+            inline_.reserve(std::max(required, inline_.capacity() * 2));
+        }
+        inline_.resize(required);
+        segments_.back().size += n;
+        total_ += n;
+        return inline_.data() + old_size;
+    }
+
+    void frame_builder::push_ref(std::span<const uint8_t> payload) {
+        if (payload.empty()) {
+            return;
+        }
+        segments_.push_back({payload.data(), 0, payload.size()});
+        total_ += payload.size();
+    }
+
+    void frame_builder::push_bytes(std::span<const uint8_t> payload) {
+        if (payload.size() < copy_threshold_) {
+            push_byte_array(payload.data(), payload.size());
+        } else {
+            push_ref(payload);
+        }
+    }
+
+    void frame_builder::clear() {
+        inline_.clear();
+        segments_.clear();
+        total_ = 0;
+    }
+
+    std::vector<uint8_t> frame_builder::to_bytes() const {
+        std::vector<uint8_t> out;
+        out.reserve(total_);
+        for (const auto& seg : segments_) {
+            const uint8_t* p = seg.data != nullptr ? seg.data : inline_.data() + seg.offset;
+            out.insert(out.end(), p, p + seg.size);
+        }
+        return out;
+    }
+
+    size_t frame_builder::write_to(int fd, std::error_code& ec, size_t offset) const {
+        std::vector<io_slice> slices = make_slices(segments_, inline_.data(), offset);
+        return offset + write_all(slices, ec, [&ec, fd](io_slice* s, size_t count) -> int64_t {
+#if OS_IS_WINDOWS
+            (void)count;
+            const int n = ::_write(fd, s->base, static_cast<unsigned int>(std::min<size_t>(s->len, INT_MAX)));
+#else
+            const ssize_t n = ::writev(fd, s, static_cast<int>(std::min(count, max_iov)));
+#endif
+            if (n < 0 && errno != EINTR) {
+                ec = std::error_code(errno, std::generic_category());
+            }
+            return n;
+        });
+    }
+
+    size_t frame_builder::send_to(intptr_t socket, std::error_code& ec, size_t offset) const {
+        std::vector<io_slice> slices = make_slices(segments_, inline_.data(), offset);
+#if OS_IS_WINDOWS
+        std::vector<WSABUF> bufs(slices.size());
+        return offset + write_all(slices, ec, [&ec, &bufs, socket](io_slice* s, size_t count) -> int64_t {
+            for (size_t i = 0; i < count; ++i) {
+                bufs[i].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(s[i].base));
+                bufs[i].len = static_cast<ULONG>(s[i].len);
+            }
+            DWORD sent = 0;
+            if (::WSASend(static_cast<SOCKET>(socket), bufs.data(), static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) != 0) {
+                ec = std::error_code(::WSAGetLastError(), std::system_category());
+                return -1;
+            }
+            return static_cast<int64_t>(sent);
+        });
+#else
+        return offset + write_all(slices, ec, [&ec, socket](io_slice* s, size_t count) -> int64_t {
+            struct msghdr msg {};
+            msg.msg_iov    = s;
+            msg.msg_iovlen = std::min(count, max_iov);
+#if defined(MSG_NOSIGNAL)
+            constexpr int flags = MSG_NOSIGNAL;
+#else
+            constexpr int flags = 0;
+#endif
+            const ssize_t n = ::sendmsg(static_cast<int>(socket), &msg, flags);
+            if (n < 0 && errno != EINTR) {
+                ec = std::error_code(errno, std::generic_category());
+            }
+            return n;
+        });
+#endif
+    }
+
+}  // namespace quant1x
@@ -0,0 +1,279 @@
+#pragma once
+#ifndef QUANT1X_STD_FRAME_H
+#define QUANT1X_STD_FRAME_H 1
+
+#include "buffer.h"
+
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace quant1x {
+
+    /**
+     * @brief 分散/聚集(scatter-gather)报文构造器
+     * @details 报文由若干段组成: 小的头部字段通过 push_* 编码到内部缓冲区, 大的负载通过 push_ref
+     * 只记录地址和长度, 不做拷贝. 输出时一次 writev/sendmsg 把所有段交给内核.
+     * 被引用的负载必须在 write_to/send_to 返回之前保持有效.
+     */
+    class frame_builder : public BinaryWriter<frame_builder> {
+    private:
+        friend class BinaryWriter<frame_builder>;
+
+        // data 为空表示内联段, 数据位于 inline_ 的 offset 处; 内联缓冲区扩容后地址会变化, 所以记录偏移
+        struct segment {
+            const uint8_t* data;
+            size_t         offset;
+            size_t         size;
+        };
+
+        byte_buffer          inline_;
+        std::vector<segment> segments_;
+        size_t               total_ = 0;
+        size_t               copy_threshold_;
+
+        uint8_t* prepare(size_t n);
+
+    public:
+        // 默认小于该长度的负载直接拷贝, 减少 iovec 段数
+        static constexpr size_t default_copy_threshold = 256;
+
+        explicit frame_builder(size_t inline_capacity = 256, size_t copy_threshold = default_copy_threshold);
+
+        frame_builder(const frame_builder&) = delete;
+        frame_builder& operator=(const frame_builder&) = delete;
+        frame_builder(frame_builder&&) noexcept = default;
+        frame_builder& operator=(frame_builder&&) noexcept = default;
+
+        // 引用外部负载, 不拷贝
+        void push_ref(std::span<const uint8_t> payload);
+
+        void push_ref(std::string_view payload) {
+            push_ref(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()));
+        }
+
+        // 小负载拷贝, 大负载引用
+        void push_bytes(std::span<const uint8_t> payload);
+
+        // u32长度前缀 + 引用负载, 与 push_length_prefixed_string 的编码一致
+        void push_length_prefixed_ref(std::span<const uint8_t> payload) {
+            push_u32(static_cast<uint32_t>(payload.size()));
+            push_ref(payload);
+        }
+
+        void push_length_prefixed_ref(std::string_view payload) {
+            push_u32(static_cast<uint32_t>(payload.size()));
+            push_ref(payload);
+        }
+
+        // 报文总字节数
+        [[nodiscard]] size_t size() const { return total_; }
+
+        // 段数
+        [[nodiscard]] size_t segment_count() const { return segments_.size(); }
+
+        // 清空, 保留容量以便复用
+        void clear();
+
+        // 拼接成连续内存, 用于调试或不支持聚集写的场景
+        [[nodiscard]] std::vector<uint8_t> to_bytes() const;
+
+        /**
+         * @brief 通过 writev 写入文件描述符, 自动处理部分写入
+         * @details 非阻塞描述符返回 EAGAIN/EWOULDBLOCK 时 ec 为对应错误, 返回值是已经写出的位置,
+         * 等可写之后以返回值作为 offset 再次调用即可续写. 期间报文和被引用的负载不能修改.
+         * @param fd 文件描述符
+         * @param ec 错误码
+         * @param offset 从报文的第 offset 个字节开始写
+         * @return 已写出的位置, 即 offset 加上本次写入的字节数, 等于 size() 表示写完
+         */
+        size_t write_to(int fd, std::error_code& ec, size_t offset = 0) const;
+
+        /**
+         * @brief 通过 sendmsg(Windows 下为 WSASend) 发送到套接字, 自动处理部分写入
+         * @details 续写约定与 write_to 相同
+         * @param socket 套接字
+         * @param ec 错误码
+         * @param offset 从报文的第 offset 个字节开始发送
+         * @return 已发送的位置, 即 offset 加上本次发送的字节数
+         */
+        size_t send_to(intptr_t socket, std::error_code& ec, size_t offset = 0) const;
+    };
+
+    /**
+     * @brief 帧头格式
+     * @details 帧总长 = header_size + 长度字段的值 + length_adjustment.
+     * 默认与 push_length_prefixed_string 一致: 偏移0处的u32小端长度, 后面紧跟负载.
+     * 例如通达信响应头: 16字节头, 偏移12处的u16为压缩后的负载长度, 可配置为 {12, 2, 16}.
+     */
+    struct frame_format {
+        size_t  length_offset     = 0;                 ///< 长度字段在帧头中的偏移
+        size_t  length_size       = 4;                 ///< 长度字段的字节数: 1, 2, 4, 8
+        size_t  header_size       = 4;                 ///< 帧头字节数, 负载从这里开始
+        int64_t length_adjustment = 0;                 ///< 长度字段的修正值, 例如长度包含帧头时为 -header_size
+        bool    big_endian        = false;             ///< 长度字段是否为大端序
+        size_t  max_frame_size    = 64 * 1024 * 1024;  ///< 帧总长上限, 超过视为错误
+    };
+
+    enum class frame_status {
+        ok,               ///< 正常
+        frame_too_large,  ///< 帧长度超过 max_frame_size
+        malformed,        ///< 帧头格式或长度非法
+    };
+
+    /**
+     * @brief 完整的一帧, 视图只在回调期间有效
+     */
+    struct frame_view {
+        std::span<const uint8_t> header;
+        std::span<const uint8_t> payload;
+
+        [[nodiscard]] BinaryStreamView reader() const {
+            return BinaryStreamView(payload);
+        }
+    };
+
+    /**
+     * @brief 增量式长度前缀帧解码器
+     * @details 接收任意切分的字节块, 完整落在当前块内的帧直接以视图形式交给回调, 不做拷贝;
+     * 只有跨块的残余部分才暂存到内部缓冲区, 补齐后再回调. 每个字节只处理一次, 热路径不抛出异常,
+     * 出错后解码器停在错误状态, 需要 reset 之后才能继续使用.
+     */
+    class frame_decoder {
+    private:
+        frame_format format_;
+        byte_buffer  pending_;
+        size_t       expected_ = 0;  // 暂存帧的总长, 0表示帧头尚未收齐
+        frame_status status_   = frame_status::ok;
+
+        // 根据帧头计算帧总长, 0表示出错(status_已设置)
+        size_t frame_length(const uint8_t* header) noexcept {
+            const uint8_t* p = header + format_.length_offset;
+            uint64_t len = 0;
+            for (size_t i = 0; i < format_.length_size; ++i) {
+                const size_t k = format_.big_endian ? i : format_.length_size - 1 - i;
+                len = (len << 8) | p[k];
+            }
+            // 先拦截8字节长度字段的极端值, 避免下面的有符号运算溢出
+            if (len > (uint64_t(1) << 62)) {
+                status_ = frame_status::frame_too_large;
+                return 0;
+            }
+            const int64_t total = static_cast<int64_t>(format_.header_size) + static_cast<int64_t>(len) + format_.length_adjustment;
+            if (total < static_cast<int64_t>(format_.header_size)) {
+                status_ = frame_status::malformed;
+                return 0;
+            }
+            if (static_cast<uint64_t>(total) > format_.max_frame_size) {
+                status_ = frame_status::frame_too_large;
+                return 0;
+            }
+            return static_cast<size_t>(total);
+        }
+
+        template <typename F>
+        void emit(const uint8_t* frame, size_t total, F& on_frame) {
+            frame_view view{{frame, format_.header_size}, {frame + format_.header_size, total - format_.header_size}};
+            on_frame(static_cast<const frame_view&>(view));
+        }
+
+        // 追加到暂存区, 返回消耗的字节数
+        size_t stash(const uint8_t* p, size_t n, size_t want) {
+            const size_t take = std::min(n, want - pending_.size());
+            pending_.insert(pending_.end(), p, p + take);
+            return take;
+        }
+
+    public:
+        explicit frame_decoder(const frame_format& format = {}) : format_(format) {
+            if (format_.length_size == 0 || format_.length_size > 8 ||
+                format_.length_offset + format_.length_size > format_.header_size) {
+                status_ = frame_status::malformed;
+            }
+        }
+
+        /**
+         * @brief 输入一块数据, 每解出一个完整帧调用一次 on_frame(const frame_view&)
+         * @return 解码状态
+         */
+        template <typename F>
+        frame_status feed(std::span<const uint8_t> chunk, F&& on_frame) {
+            if (status_ != frame_status::ok) {
+                return status_;
+            }
+            const uint8_t* p = chunk.data();
+            size_t         n = chunk.size();
+            const size_t   header_size = format_.header_size;
+
+            // 1. 先补齐上一块残留的帧
+            if (!pending_.empty()) {
+                if (expected_ == 0) {
+                    const size_t used = stash(p, n, header_size);
+                    p += used;
+                    n -= used;
+                    if (pending_.size() < header_size) {
+                        return status_;
+                    }
+                    expected_ = frame_length(pending_.data());
+                    if (expected_ == 0) {
+                        return status_;
+                    }
+                    pending_.reserve(expected_);
+                }
+                const size_t used = stash(p, n, expected_);
+                p += used;
+                n -= used;
+                if (pending_.size() < expected_) {
+                    return status_;
+                }
+                emit(pending_.data(), expected_, on_frame);
+                pending_.clear();
+                expected_ = 0;
+            }
+
+            // 2. 完整落在本块内的帧, 零拷贝
+            while (n >= header_size) {
+                const size_t total = frame_length(p);
+                if (total == 0) {
+                    return status_;
+                }
+                if (n < total) {
+                    expected_ = total;
+                    break;
+                }
+                emit(p, total, on_frame);
+                p += total;
+                n -= total;
+            }
+
+            // 3. 残余部分暂存
+            if (n > 0) {
+                pending_.reserve(std::max(expected_, header_size));
+                pending_.insert(pending_.end(), p, p + n);
+            }
+            return status_;
+        }
+
+        template <typename F>
+        frame_status feed(std::string_view chunk, F&& on_frame) {
+            return feed(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size()),
+                        std::forward<F>(on_frame));
+        }
+
+        // 暂存中尚未组成完整帧的字节数
+        [[nodiscard]] size_t buffered() const { return pending_.size(); }
+
+        [[nodiscard]] frame_status status() const { return status_; }
+
+        // 丢弃暂存数据并清除错误状态
+        void reset() {
+            pending_.clear();
+            expected_ = 0;
+            status_   = frame_status::ok;
+        }
+    };
+
+}  // namespace quant1x
+
+#endif  // QUANT1X_STD_FRAME_H
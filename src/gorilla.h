@@ -0,0 +1,402 @@
+#pragma once
+#ifndef QUANT1X_STD_GORILLA_H
+#define QUANT1X_STD_GORILLA_H 1
+
+#include "buffer.h"
+
+#include <bit>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Gorilla 风格的时间序列压缩
+ *
+ * 时间戳按二阶差分(delta-of-delta)编码, 等间隔的tick只占1个比特;
+ * 浮点数与前一个值做异或, 只保存有效比特, 价格不变时只占1个比特.
+ * 编码结果: uleb128(tick数) + uleb128(字节数) + 比特流, 可以直接追加到任意 BinaryWriter.
+ */
+namespace quant1x {
+
+    /**
+     * @brief 比特写入器, 高位在前, 每凑满64比特向下层写入一次
+     */
+    template <typename W>
+    class bit_writer {
+    private:
+        BinaryWriter<W>* out_;
+        uint64_t         acc_  = 0;  // 尚未写出的比特, 靠低位对齐
+        unsigned         used_ = 0;  // acc_ 中的比特数
+        size_t           bits_ = 0;
+
+        void put_word(uint64_t word) {
+            uint8_t bytes[8];
+            for (size_t i = 0; i < 8; ++i) {
+                bytes[i] = static_cast<uint8_t>(word >> (56 - 8 * i));
+            }
+            out_->push_byte_array(bytes);
+        }
+
+    public:
+        explicit bit_writer(BinaryWriter<W>& out) : out_(&out) {}
+
+        /**
+         * @brief 写入 value 的低 nbits 个比特
+         * @param nbits 0~64
+         */
+        void write(uint64_t value, unsigned nbits) {
+            if (nbits == 0) {
+                return;
+            }
+            if (nbits < 64) {
+                value &= (uint64_t(1) << nbits) - 1;
+            }
+            bits_ += nbits;
+            const unsigned room = 64 - used_;
+            if (nbits < room) {
+                acc_ = (acc_ << nbits) | value;
+                used_ += nbits;
+                return;
+            }
+            const unsigned rest = nbits - room;
+            put_word(room == 64 ? value : (acc_ << room) | (value >> rest));
+            acc_  = rest == 0 ? 0 : value & ((uint64_t(1) << rest) - 1);
+            used_ = rest;
+        }
+
+        void write_bit(bool bit) {
+            write(bit ? 1 : 0, 1);
+        }
+
+        // 写出剩余比特, 不足一个字节的部分补0
+        void flush() {
+            if (used_ == 0) {
+                return;
+            }
+            const uint64_t word = acc_ << (64 - used_);
+            for (unsigned i = 0; i < (used_ + 7) / 8; ++i) {
+                out_->push_u8(static_cast<uint8_t>(word >> (56 - 8 * i)));
+            }
+            acc_  = 0;
+            used_ = 0;
+        }
+
+        // 已写入的比特数
+        [[nodiscard]] size_t bits() const { return bits_; }
+    };
+
+    /**
+     * @brief 比特读取器, 高位在前, 数据不足时抛出 std::out_of_range
+     */
+    class bit_reader {
+    private:
+        const uint8_t* data_;
+        size_t         size_;
+        size_t         pos_ = 0;  // 比特偏移
+
+        // 从 byte 处按大端读取8个字节, 越界部分补0
+        [[nodiscard]] uint64_t load_word(size_t byte) const noexcept {
+            uint64_t word = 0;
+            if (byte + 8 <= size_) {
+                std::memcpy(&word, data_ + byte, 8);
+#if ENDIAN_LITTLE
+                word = quant1x::detail::byteswap(word);
+#endif
+                return word;
+            }
+            for (size_t i = 0; i < 8; ++i) {
+                word <<= 8;
+                if (byte + i < size_) {
+                    word |= data_[byte + i];
+                }
+            }
+            return word;
+        }
+
+    public:
+        explicit bit_reader(std::span<const uint8_t> data) : data_(data.data()), size_(data.size()) {}
+
+        /**
+         * @brief 读取 nbits 个比特
+         * @param nbits 0~64
+         */
+        uint64_t read(unsigned nbits) {
+            if (nbits == 0) {
+                return 0;
+            }
+            if (nbits > size_ * 8 - pos_) {
+                throw std::out_of_range("Insufficient bits in buffer");
+            }
+            const size_t   byte  = pos_ >> 3;
+            const unsigned shift = static_cast<unsigned>(pos_ & 7);
+            pos_ += nbits;
+            const uint64_t word  = load_word(byte) << shift;
+            uint64_t       value = word >> (64 - nbits);
+            const unsigned have  = 64 - shift;
+            if (nbits > have) {
+                value |= data_[byte + 8] >> (8 - (nbits - have));
+            }
+            return value;
+        }
+
+        bool read_bit() {
+            return read(1) != 0;
+        }
+
+        // 剩余比特数
+        [[nodiscard]] size_t remaining() const { return size_ * 8 - pos_; }
+    };
+
+    /**
+     * @brief tick序列编码器, 每个tick为(时间戳, 浮点值)
+     * @details 比特流先缓存在内部, finish 时连同头部一起写入目标流. clear 之后可以复用.
+     */
+    class gorilla_encoder {
+    private:
+        BinaryStreamWriter             buffer_;
+        bit_writer<BinaryStreamWriter> bits_{buffer_};
+        size_t                         count_     = 0;
+        int64_t                        timestamp_ = 0;
+        int64_t                        delta_     = 0;
+        uint64_t                       value_     = 0;
+        unsigned                       leading_   = 64;  // 上一个异或块的前导0个数, 64表示还没有
+        unsigned                       trailing_  = 0;
+
+        void append_timestamp(int64_t timestamp) {
+            const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(timestamp) - static_cast<uint64_t>(timestamp_));
+            const int64_t dod   = static_cast<int64_t>(static_cast<uint64_t>(delta) - static_cast<uint64_t>(delta_));
+            timestamp_          = timestamp;
+            delta_              = delta;
+            if (dod == 0) {
+                bits_.write(0b0, 1);
+            } else if (dod >= -64 && dod < 64) {
+                bits_.write(0b10, 2);
+                bits_.write(static_cast<uint64_t>(dod), 7);
+            } else if (dod >= -256 && dod < 256) {
+                bits_.write(0b110, 3);
+                bits_.write(static_cast<uint64_t>(dod), 9);
+            } else if (dod >= -2048 && dod < 2048) {
+                bits_.write(0b1110, 4);
+                bits_.write(static_cast<uint64_t>(dod), 12);
+            } else {
+                bits_.write(0b1111, 4);
+                bits_.write(static_cast<uint64_t>(dod), 64);
+            }
+        }
+
+        void append_value(double value) {
+            const uint64_t bits = std::bit_cast<uint64_t>(value);
+            const uint64_t x    = bits ^ value_;
+            value_              = bits;
+            if (x == 0) {
+                bits_.write(0b0, 1);
+                return;
+            }
+            // 前导0用5个比特保存, 最多31
+            const unsigned leading  = std::min(static_cast<unsigned>(std::countl_zero(x)), 31u);
+            const unsigned trailing = static_cast<unsigned>(std::countr_zero(x));
+            if (leading_ != 64 && leading >= leading_ && trailing >= trailing_) {
+                // 有效比特落在上一个窗口内, 沿用窗口
+                bits_.write(0b10, 2);
+                bits_.write(x >> trailing_, 64 - leading_ - trailing_);
+                return;
+            }
+            const unsigned meaningful = 64 - leading - trailing;
+            bits_.write(0b11, 2);
+            bits_.write(leading, 5);
+            bits_.write(meaningful & 63, 6);  // 64 记为 0
+            bits_.write(x >> trailing, meaningful);
+            leading_  = leading;
+            trailing_ = trailing;
+        }
+
+    public:
+        gorilla_encoder() = default;
+
+        explicit gorilla_encoder(size_t capacity) : buffer_(capacity) {}
+
+        gorilla_encoder(const gorilla_encoder&) = delete;
+        gorilla_encoder& operator=(const gorilla_encoder&) = delete;
+
+        void append(int64_t timestamp, double value) {
+            if (count_ == 0) {
+                bits_.write(static_cast<uint64_t>(timestamp), 64);
+                bits_.write(std::bit_cast<uint64_t>(value), 64);
+                timestamp_ = timestamp;
+                value_     = std::bit_cast<uint64_t>(value);
+            } else {
+                append_timestamp(timestamp);
+                append_value(value);
+            }
+            ++count_;
+        }
+
+        void append(std::span<const int64_t> timestamps, std::span<const double> values) {
+            if (timestamps.size() != values.size()) {
+                throw std::invalid_argument("timestamps and values size mismatch");
+            }
+            for (size_t i = 0; i < values.size(); ++i) {
+                append(timestamps[i], values[i]);
+            }
+        }
+
+        // tick数
+        [[nodiscard]] size_t size() const { return count_; }
+
+        // 比特流占用的字节数
+        [[nodiscard]] size_t encoded_bytes() const { return (bits_.bits() + 7) / 8; }
+
+        /**
+         * @brief 写入头部和比特流
+         * @details 之后不能再追加, 需要 clear
+         */
+        template <typename W>
+        void finish(BinaryWriter<W>& w) {
+            bits_.flush();
+            w.push_uleb128(count_);
+            w.push_uleb128(buffer_.size());
+            w.push_byte_array(buffer_.data().data(), buffer_.size());
+        }
+
+        void clear() {
+            buffer_.clear();
+            bits_      = bit_writer<BinaryStreamWriter>(buffer_);
+            count_     = 0;
+            timestamp_ = 0;
+            delta_     = 0;
+            value_     = 0;
+            leading_   = 64;
+            trailing_  = 0;
+        }
+    };
+
+    /**
+     * @brief tick序列解码器, 直接在输入缓冲区上解码, 不拷贝比特流
+     */
+    class gorilla_decoder {
+    private:
+        bit_reader bits_;
+        size_t     count_     = 0;
+        size_t     index_     = 0;
+        int64_t    timestamp_ = 0;
+        int64_t    delta_     = 0;
+        uint64_t   value_     = 0;
+        unsigned   leading_   = 0;
+        unsigned   trailing_  = 0;
+
+        // 读取 n 比特的补码并做符号扩展
+        int64_t read_signed(unsigned n) {
+            const uint64_t v = bits_.read(n);
+            if (n == 64) {
+                return static_cast<int64_t>(v);
+            }
+            const uint64_t sign = uint64_t(1) << (n - 1);
+            return static_cast<int64_t>((v ^ sign) - sign);
+        }
+
+        int64_t next_timestamp() {
+            int64_t dod = 0;
+            if (bits_.read_bit()) {
+                if (!bits_.read_bit()) {
+                    dod = read_signed(7);
+                } else if (!bits_.read_bit()) {
+                    dod = read_signed(9);
+                } else if (!bits_.read_bit()) {
+                    dod = read_signed(12);
+                } else {
+                    dod = read_signed(64);
+                }
+            }
+            delta_     = static_cast<int64_t>(static_cast<uint64_t>(delta_) + static_cast<uint64_t>(dod));
+            timestamp_ = static_cast<int64_t>(static_cast<uint64_t>(timestamp_) + static_cast<uint64_t>(delta_));
+            return timestamp_;
+        }
+
+        double next_value() {
+            if (bits_.read_bit()) {
+                if (bits_.read_bit()) {
+                    leading_            = static_cast<unsigned>(bits_.read(5));
+                    unsigned meaningful = static_cast<unsigned>(bits_.read(6));
+                    if (meaningful == 0) {
+                        meaningful = 64;
+                    }
+                    if (leading_ + meaningful > 64) {
+                        throw std::out_of_range("Malformed gorilla block");
+                    }
+                    trailing_ = 64 - leading_ - meaningful;
+                }
+                value_ ^= bits_.read(64 - leading_ - trailing_) << trailing_;
+            }
+            return std::bit_cast<double>(value_);
+        }
+
+    public:
+        /**
+         * @brief 从流中读取一段编码结果, 流的偏移量移到这一段之后
+         * @details 比特流以视图方式引用, 需要保持底层缓冲区有效
+         */
+        template <typename R>
+        explicit gorilla_decoder(BinaryReader<R>& r) : bits_(std::span<const uint8_t>()) {
+            count_             = r.get_uleb128();
+            const size_t bytes = r.get_uleb128();
+            bits_              = bit_reader(r.get_bytes_view(bytes));
+            // 第一个tick占128比特, 之后每个tick至少2比特, 提前拦截损坏的头部
+            if (count_ > 1 && count_ - 1 > bytes * 4) {
+                throw std::out_of_range("Malformed gorilla header");
+            }
+        }
+
+        // tick总数
+        [[nodiscard]] size_t size() const { return count_; }
+
+        // 尚未读取的tick数
+        [[nodiscard]] size_t remaining() const { return count_ - index_; }
+
+        /**
+         * @brief 读取下一个tick
+         * @return false 表示已经读完
+         */
+        bool next(int64_t& timestamp, double& value) {
+            if (index_ == count_) {
+                return false;
+            }
+            if (index_ == 0) {
+                timestamp_ = static_cast<int64_t>(bits_.read(64));
+                value_     = bits_.read(64);
+                timestamp  = timestamp_;
+                value      = std::bit_cast<double>(value_);
+            } else {
+                timestamp = next_timestamp();
+                value     = next_value();
+            }
+            ++index_;
+            return true;
+        }
+
+        // 批量解码剩余的tick, 追加到输出
+        void decode(std::vector<int64_t>& timestamps, std::vector<double>& values) {
+            timestamps.reserve(timestamps.size() + remaining());
+            values.reserve(values.size() + remaining());
+            int64_t ts;
+            double  v;
+            while (next(ts, v)) {
+                timestamps.push_back(ts);
+                values.push_back(v);
+            }
+        }
+
+        // 批量解码剩余的浮点值, 时间戳丢弃
+        void decode(std::vector<double>& values) {
+            values.reserve(values.size() + remaining());
+            int64_t ts;
+            double  v;
+            while (next(ts, v)) {
+                values.push_back(v);
+            }
+        }
+    };
+
+}  // namespace quant1x
+
+#endif  // QUANT1X_STD_GORILLA_H
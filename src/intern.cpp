@@ -0,0 +1,208 @@
+#include "intern.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "buffer.h"
+
+namespace quant1x {
+
+    namespace {
+
+        constexpr uint32_t snapshot_magic   = 0x4E495851;  // "QXIN"
+        constexpr uint32_t snapshot_version = 1;
+
+        // 第 k 段的起始编号
+        constexpr size_t segment_base(size_t k, size_t bits) noexcept {
+            return ((size_t(1) << k) - 1) << bits;
+        }
+
+    }  // namespace
+
+    string_pool::table::table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<uint32_t>[capacity]) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    string_pool::string_pool(size_t capacity) {
+        auto t = std::make_unique<table>(std::bit_ceil(std::max<size_t>(capacity * 2, 16)));
+        table_.store(t.get(), std::memory_order_release);
+        tables_.push_back(std::move(t));
+    }
+
+    string_pool::~string_pool() {
+        for (auto& segment : segments_) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    string_pool& string_pool::global() {
+        static string_pool pool(64 * 1024);
+        return pool;
+    }
+
+    uint32_t string_pool::hash(std::string_view str) noexcept {
+        const uint64_t h = std::hash<std::string_view>{}(str);
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+    const string_pool::entry* string_pool::at(uint32_t id) const noexcept {
+        // 编号 id 位于第 k 段: id + first_segment 的最高位决定 k
+        const size_t j = size_t(id) + (size_t(1) << first_segment_bits);
+        const size_t k = static_cast<size_t>(std::bit_width(j)) - 1 - first_segment_bits;
+        const entry* segment = segments_[k].load(std::memory_order_acquire);
+        return segment + (id - segment_base(k, first_segment_bits));
+    }
+
+    uint32_t string_pool::lookup(const table* t, std::string_view str, uint32_t h) const noexcept {
+        for (size_t i = h & t->mask;; i = (i + 1) & t->mask) {
+            const uint32_t slot = t->slots[i].load(std::memory_order_acquire);
+            if (slot == 0) {
+                return npos;
+            }
+            const entry* e = at(slot - 1);
+            if (e->hash == h && std::string_view(e->data, e->size) == str) {
+                return slot - 1;
+            }
+        }
+    }
+
+    uint32_t string_pool::find(std::string_view str) const noexcept {
+        return lookup(table_.load(std::memory_order_acquire), str, hash(str));
+    }
+
+    std::string_view string_pool::view(uint32_t id) const noexcept {
+        if (id >= size_.load(std::memory_order_acquire)) {
+            return {};
+        }
+        const entry* e = at(id);
+        return {e->data, e->size};
+    }
+
+    const char* string_pool::store(std::string_view str) {
+        if (str.size() > arena_block / 4) {
+            // 大字符串单独分配, 不打断当前块
+            arena_.emplace_back(new char[str.size()]);
+            std::memcpy(arena_.back().get(), str.data(), str.size());
+            return arena_.back().get();
+        }
+        if (block_ == nullptr || block_used_ + str.size() > arena_block) {
+            arena_.emplace_back(new char[arena_block]);
+            block_      = arena_.back().get();
+            block_used_ = 0;
+        }
+        char* p = block_ + block_used_;
+        std::memcpy(p, str.data(), str.size());
+        block_used_ += str.size();
+        return p;
+    }
+
+    void string_pool::insert_slot(table* t, uint32_t id, uint32_t h) noexcept {
+        size_t i = h & t->mask;
+        while (t->slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & t->mask;
+        }
+        t->slots[i].store(id + 1, std::memory_order_release);
+    }
+
+    void string_pool::grow() {
+        const table* old = table_.load(std::memory_order_relaxed);
+        auto t = std::make_unique<table>((old->mask + 1) * 2);
+        const uint32_t n = size_.load(std::memory_order_relaxed);
+        for (uint32_t id = 0; id < n; ++id) {
+            insert_slot(t.get(), id, at(id)->hash);
+        }
+        table_.store(t.get(), std::memory_order_release);
+        tables_.push_back(std::move(t));
+    }
+
+    uint32_t string_pool::intern(std::string_view str) {
+        const uint32_t h = hash(str);
+        if (const uint32_t id = lookup(table_.load(std::memory_order_acquire), str, h); id != npos) {
+            return id;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 锁内复查, 其他线程可能刚插入, 或者刚才读到的是已退役的旧表
+        table* t = table_.load(std::memory_order_relaxed);
+        if (const uint32_t id = lookup(t, str, h); id != npos) {
+            return id;
+        }
+        const uint32_t id = size_.load(std::memory_order_relaxed);
+        if (id == npos) {
+            throw std::length_error("string_pool is full");
+        }
+        const size_t j = size_t(id) + (size_t(1) << first_segment_bits);
+        const size_t k = static_cast<size_t>(std::bit_width(j)) - 1 - first_segment_bits;
+        if (segments_[k].load(std::memory_order_relaxed) == nullptr) {
+            segments_[k].store(new entry[size_t(1) << (first_segment_bits + k)], std::memory_order_release);
+        }
+        entry* e = segments_[k].load(std::memory_order_relaxed) + (id - segment_base(k, first_segment_bits));
+        *e = entry{store(str), static_cast<uint32_t>(str.size()), h};
+        // 先发布条目, 再发布槽位, 读线程通过槽位拿到编号时条目已经可见
+        size_.store(id + 1, std::memory_order_release);
+        // 负载因子不超过 1/2
+        if (size_t(id + 1) * 2 > t->mask + 1) {
+            grow();
+        } else {
+            insert_slot(t, id, h);
+        }
+        return id;
+    }
+
+    bool string_pool::save(const std::string& path, std::error_code& ec) const {
+        ec.clear();
+        const uint32_t n = size_.load(std::memory_order_acquire);
+        BinaryStreamWriter writer;
+        writer.push_u32(snapshot_magic);
+        writer.push_u32(snapshot_version);
+        writer.push_u32(n);
+        for (uint32_t id = 0; id < n; ++id) {
+            writer.push_length_prefixed_string(view(id));
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const auto data = writer.data();
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            ec = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        return true;
+    }
+
+    bool string_pool::load(const std::string& path, std::error_code& ec) {
+        ec.clear();
+        if (size() != 0) {
+            ec = std::make_error_code(std::errc::operation_not_permitted);
+            return false;
+        }
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            return false;
+        }
+        const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        try {
+            BinaryStreamView reader(data.data(), data.size());
+            if (reader.get_u32() != snapshot_magic || reader.get_u32() != snapshot_version) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            const uint32_t n = reader.get_u32();
+            for (uint32_t id = 0; id < n; ++id) {
+                // 文件中出现重复字符串时编号会错位
+                if (intern(reader.get_length_prefixed_string()) != id) {
+                    ec = std::make_error_code(std::errc::invalid_argument);
+                    return false;
+                }
+            }
+        } catch (const std::out_of_range&) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        return true;
+    }
+
+}  // namespace quant1x
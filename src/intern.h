@@ -0,0 +1,117 @@
+#pragma once
+#ifndef QUANT1X_STD_INTERN_H
+#define QUANT1X_STD_INTERN_H 1
+
+#include "base.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace quant1x {
+
+    /**
+     * @brief 线程安全的字符串驻留池, 字符串与稠密的 uint32_t 编号一一对应
+     * @details
+     * - 编号从0开始连续分配, 热路径可以用编号作为数组下标, 代替以字符串为键的 map
+     * - 字符串存放在只增不减的内存块中, view 返回的视图在池销毁之前一直有效
+     * - 查找已驻留的字符串(find/intern 命中)和按编号取回(view)都不加锁; 只有插入新字符串时加锁
+     * - 哈希表为开放寻址, 槽位是原子编号. 扩容时建新表后原子替换, 旧表保留到池销毁,
+     *   正在读旧表的线程不受影响(最多漏看刚插入的字符串, intern 会在锁内复查)
+     * tsl::robin_map 插入时会移动元素, 无法在写入的同时无锁读取, 所以这里没有使用.
+     */
+    class string_pool {
+    public:
+        static constexpr uint32_t npos = UINT32_MAX;
+
+        explicit string_pool(size_t capacity = 1024);
+        ~string_pool();
+
+        string_pool(const string_pool&) = delete;
+        string_pool& operator=(const string_pool&) = delete;
+
+        // 驻留字符串, 返回编号; 已存在时直接返回原编号
+        uint32_t intern(std::string_view str);
+
+        // 查找编号, 不存在时返回 npos, 不加锁
+        [[nodiscard]] uint32_t find(std::string_view str) const noexcept;
+
+        // 按编号取回字符串, 编号越界时返回空视图, 不加锁
+        [[nodiscard]] std::string_view view(uint32_t id) const noexcept;
+
+        // 已驻留的字符串个数, 即下一个编号
+        [[nodiscard]] size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief 按编号顺序保存到文件, 下次启动时 load 恢复相同的编号
+         */
+        bool save(const std::string& path, std::error_code& ec) const;
+
+        /**
+         * @brief 从 save 生成的文件恢复
+         * @details 只能在空池上调用, 否则编号无法与文件一致, 返回 operation_not_permitted
+         */
+        bool load(const std::string& path, std::error_code& ec);
+
+        // 进程级的全局池
+        static string_pool& global();
+
+    private:
+        struct entry {
+            const char* data;
+            uint32_t    size;
+            uint32_t    hash;
+        };
+
+        struct table {
+            size_t                                 mask;
+            std::unique_ptr<std::atomic<uint32_t>[]> slots;  // 编号+1, 0表示空
+
+            explicit table(size_t capacity);
+        };
+
+        // 编号按段存放, 第 k 段容量为 first_segment << k, 段一旦分配不再移动
+        static constexpr size_t first_segment_bits = 10;
+        static constexpr size_t max_segments       = 32 - first_segment_bits + 1;
+        static constexpr size_t arena_block        = 64 * 1024;
+
+        std::atomic<entry*>                 segments_[max_segments] = {};
+        std::atomic<uint32_t>               size_{0};
+        std::atomic<table*>                 table_{nullptr};
+        std::vector<std::unique_ptr<table>> tables_;  // 当前表和已退役的旧表
+        std::vector<std::unique_ptr<char[]>> arena_;
+        char*                               block_      = nullptr;  // 当前块
+        size_t                              block_used_ = 0;
+        std::mutex                          mutex_;
+
+        static uint32_t hash(std::string_view str) noexcept;
+
+        const entry* at(uint32_t id) const noexcept;
+
+        uint32_t lookup(const table* t, std::string_view str, uint32_t h) const noexcept;
+
+        const char* store(std::string_view str);
+
+        void insert_slot(table* t, uint32_t id, uint32_t h) noexcept;
+
+        void grow();
+    };
+
+    // 驻留到全局池
+    inline uint32_t intern(std::string_view str) {
+        return string_pool::global().intern(str);
+    }
+
+    // 从全局池取回
+    inline std::string_view interned(uint32_t id) noexcept {
+        return string_pool::global().view(id);
+    }
+
+}  // namespace quant1x
+
+#endif  // QUANT1X_STD_INTERN_H
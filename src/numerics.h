@@ -76,16 +76,16 @@ namespace numerics {
             min_ = std::numeric_limits<T>::lowest();
             max_ = std::numeric_limits<T>::max();
 
-            std::string text = strings::trim(str);
-            size_t      pos  = text.find('~');
+            std::string_view text = strings::trim_view(str);
+            size_t           pos  = text.find('~');
 
             if (pos == std::string::npos) {
                 // 情况1: 无分隔符，视为最小值
                 T val = strings::from_string(text, min_);
                 min_  = val;
             } else {
-                std::string s_min = strings::trim(text.substr(0, pos));
-                std::string s_max = strings::trim(text.substr(pos + 1));
+                std::string_view s_min = strings::trim_view(text.substr(0, pos));
+                std::string_view s_max = strings::trim_view(text.substr(pos + 1));
 
                 // 情况4: 前后都为空
                 if (s_min.empty() && s_max.empty()) {
@@ -123,7 +123,7 @@ namespace numerics {
         }
 
         // 字符串表示
-        std::string to_string() const { return "{min:" + std::to_string(min_) + ", max:" + std::to_string(max_) + "}"; }
+        std::string to_string() const { return fmt::format("{}", *this); }
 
         friend std::ostream &operator<<(std::ostream &os, const number_range &range) {
             os << range.to_string();
@@ -132,4 +132,19 @@ namespace numerics {
     };
 }  // namespace numerics
 
+template <typename T>
+struct has_custom_formatter<numerics::number_range<T>> : std::true_type {};
+
+// 输出 {min:X, max:Y}, 浮点数为最短往返表示
+template <typename T>
+struct fmt::formatter<numerics::number_range<T>> {
+    constexpr auto parse(format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    auto format(const numerics::number_range<T>& range, format_context& ctx) const {
+        return fmt::format_to(ctx.out(), "{{min:{}, max:{}}}", range.min_, range.max_);
+    }
+};
+
 #endif  // QUANT1X_STD_NUMERICS_H
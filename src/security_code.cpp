@@ -0,0 +1,132 @@
+#include "security_code.h"
+
+#include <algorithm>
+#include <cstring>
+#include <xsimd/xsimd.hpp>
+
+#include "buffer.h"
+
+namespace quant1x {
+
+    namespace {
+
+        // 每8字节一组: 前2个是交易所字母, 后6个是数字
+        struct code_pattern {
+            alignas(64) uint8_t fold[64];   // 字母位置 | 0x20 转小写
+            alignas(64) uint8_t base[64];   // 'a' 或 '0'
+            alignas(64) uint8_t limit[64];  // 26 或 10
+
+            constexpr code_pattern() : fold{}, base{}, limit{} {
+                for (size_t i = 0; i < 64; ++i) {
+                    const bool letter = i % security_code::length < 2;
+                    fold[i]  = letter ? 0x20 : 0;
+                    base[i]  = letter ? 'a' : '0';
+                    limit[i] = letter ? 26 : 10;
+                }
+            }
+        };
+
+        constexpr code_pattern pattern;
+
+        // 打包一个已转小写的8字节代码
+        inline security_code pack_lowered(const uint8_t* p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+#if ENDIAN_LITTLE
+            v = detail::byteswap(v);
+#endif
+            const security_code code = security_code::from_value(v);
+            return code.valid() ? code : security_code{};
+        }
+
+        /**
+         * @brief 校验连续的 n 个8字节代码, 字母转小写后写回 lowered, 逐个交给 on_code(index, ok)
+         * @details 一个 batch 覆盖 width/8 个代码, 字符类别比较得到逐字节的位图, 某个代码对应的8位全为1才合法
+         */
+        template <typename F>
+        void scan_codes(const uint8_t* raw, uint8_t* lowered, size_t n, F&& on_code) noexcept {
+            using batch = xsimd::batch<uint8_t>;
+            constexpr size_t width = batch::size;
+            static_assert(width % security_code::length == 0 && width <= 64);
+            constexpr size_t per_batch = width / security_code::length;
+            const batch fold  = batch::load_aligned(pattern.fold);
+            const batch base  = batch::load_aligned(pattern.base);
+            const batch limit = batch::load_aligned(pattern.limit);
+            size_t i = 0;
+            for (; i + per_batch <= n; i += per_batch) {
+                const batch c = batch::load_unaligned(raw + i * security_code::length) | fold;
+                c.store_unaligned(lowered + i * security_code::length);
+                const uint64_t mask = ((c - base) < limit).mask();
+                for (size_t k = 0; k < per_batch; ++k) {
+                    on_code(i + k, ((mask >> (k * security_code::length)) & 0xFF) == 0xFF);
+                }
+            }
+            for (; i < n; ++i) {
+                bool ok = true;
+                for (size_t j = 0; j < security_code::length; ++j) {
+                    const size_t  at = i * security_code::length + j;
+                    const uint8_t c  = raw[at] | pattern.fold[j];
+                    lowered[at] = c;
+                    ok = ok && static_cast<uint8_t>(c - pattern.base[j]) < pattern.limit[j];
+                }
+                on_code(i, ok);
+            }
+        }
+
+        // 每次处理的代码个数, 收集缓冲区放在栈上
+        constexpr size_t chunk_codes = 256;
+
+    }  // namespace
+
+    security_code security_code::parse(std::string_view str) noexcept {
+        if (str.size() != length) {
+            return {};
+        }
+        uint8_t lowered[length];
+        for (size_t i = 0; i < length; ++i) {
+            lowered[i] = static_cast<uint8_t>(str[i]) | pattern.fold[i];
+        }
+        return pack_lowered(lowered);
+    }
+
+    size_t parse_security_codes(std::span<const std::string_view> codes, std::span<security_code> out) noexcept {
+        const size_t n = std::min(codes.size(), out.size());
+        uint8_t raw[chunk_codes * security_code::length];
+        uint8_t lowered[chunk_codes * security_code::length];
+        size_t  count = 0;
+        for (size_t begin = 0; begin < n; begin += chunk_codes) {
+            const size_t m = std::min(chunk_codes, n - begin);
+            // 长度不对的代码填0, 必然校验失败
+            for (size_t i = 0; i < m; ++i) {
+                const std::string_view code = codes[begin + i];
+                if (code.size() == security_code::length) {
+                    std::memcpy(raw + i * security_code::length, code.data(), security_code::length);
+                } else {
+                    std::memset(raw + i * security_code::length, 0, security_code::length);
+                }
+            }
+            scan_codes(raw, lowered, m, [&](size_t i, bool ok) {
+                out[begin + i] = ok ? pack_lowered(lowered + i * security_code::length) : security_code{};
+                count += out[begin + i].valid();
+            });
+        }
+        return count;
+    }
+
+    size_t validate_security_codes(std::span<const char> raw, std::span<bool> valid) noexcept {
+        const size_t n = std::min(raw.size() / security_code::length, valid.size());
+        const auto*  p = reinterpret_cast<const uint8_t*>(raw.data());
+        uint8_t lowered[chunk_codes * security_code::length];
+        size_t  count = 0;
+        for (size_t begin = 0; begin < n; begin += chunk_codes) {
+            const size_t m = std::min(chunk_codes, n - begin);
+            scan_codes(p + begin * security_code::length, lowered, m, [&](size_t i, bool ok) {
+                // 字符类别正确后再检查交易所前缀
+                valid[begin + i] = ok && pack_lowered(lowered + i * security_code::length).valid();
+                count += valid[begin + i];
+            });
+        }
+        return count;
+    }
+
+}  // namespace quant1x
@@ -0,0 +1,194 @@
+#pragma once
+#ifndef QUANT1X_STD_SECURITY_CODE_H
+#define QUANT1X_STD_SECURITY_CODE_H 1
+
+#include "base.h"
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace quant1x {
+
+    // 交易所
+    enum class market : uint8_t {
+        unknown,
+        sh,  ///< 上海证券交易所
+        sz,  ///< 深圳证券交易所
+        bj,  ///< 北京证券交易所
+    };
+
+    // 板块
+    enum class board : uint8_t {
+        unknown,
+        main,     ///< 主板
+        chinext,  ///< 创业板, sz300/sz301
+        star,     ///< 科创板, sh688/sh689
+        bse,      ///< 北交所
+        index,    ///< 指数, sh000/sz399
+        fund,     ///< 基金, sh5/sz15/sz16
+    };
+
+    /**
+     * @brief 8字节证券代码, 例如 "sh600000"
+     * @details 8个ASCII字符按大端序打包进一个 uint64_t: 第1个字符位于最高字节, 整数序与字典序一致.
+     * 比较、哈希都是一次整数运算, 作为 map 的键不需要堆分配. 交易所和板块通过字节掩码判断.
+     * 默认构造的值为0, 表示无效代码.
+     */
+    class security_code {
+    private:
+        uint64_t value_ = 0;
+
+        static constexpr uint64_t pack(std::string_view s) noexcept {
+            uint64_t v = 0;
+            for (size_t i = 0; i < length; ++i) {
+                v = (v << 8) | static_cast<uint8_t>(i < s.size() ? s[i] : 0);
+            }
+            return v;
+        }
+
+        // 前 n 个字符的掩码
+        static constexpr uint64_t prefix_mask(size_t n) noexcept {
+            return n >= length ? ~uint64_t(0) : ~(~uint64_t(0) >> (8 * n));
+        }
+
+    public:
+        static constexpr size_t length = 8;
+
+        constexpr security_code() noexcept = default;
+
+        // 从字面量构造, 长度必须为8, 不做校验
+        template <size_t N>
+        consteval security_code(const char (&literal)[N]) noexcept : value_(pack(std::string_view(literal, N - 1))) {
+            static_assert(N - 1 == length, "security code literal must have 8 characters");
+        }
+
+        // 从打包值构造
+        static constexpr security_code from_value(uint64_t value) noexcept {
+            security_code code;
+            code.value_ = value;
+            return code;
+        }
+
+        /**
+         * @brief 解析证券代码, 交易所前缀不区分大小写
+         * @return 格式非法(长度不是8, 前缀不是 sh/sz/bj, 或后6位不全是数字)时返回无效代码
+         */
+        static security_code parse(std::string_view str) noexcept;
+
+        [[nodiscard]] constexpr uint64_t value() const noexcept { return value_; }
+
+        // 交易所前缀已知且后6位都是数字
+        [[nodiscard]] constexpr bool valid() const noexcept {
+            // 每个字节高4位为3, 且低4位加6不进位(即不超过9)
+            constexpr uint64_t high = 0xF0F0F0F0F0F0ULL;
+            constexpr uint64_t zero = 0x303030303030ULL;
+            const uint64_t digits = value_ & 0xFFFFFFFFFFFFULL;
+            return market() != quant1x::market::unknown && (digits & high) == zero &&
+                   ((digits + 0x060606060606ULL) & high) == zero;
+        }
+
+        constexpr explicit operator bool() const noexcept { return valid(); }
+
+        // 是否以 prefix 开头, prefix 为常量时编译期算出掩码, 只剩一次与运算和比较
+        [[nodiscard]] constexpr bool starts_with(std::string_view prefix) const noexcept {
+            return (value_ & prefix_mask(prefix.size())) == pack(prefix);
+        }
+
+        [[nodiscard]] constexpr quant1x::market market() const noexcept {
+            switch (value_ >> 48) {
+                case ('s' << 8) | 'h':
+                    return quant1x::market::sh;
+                case ('s' << 8) | 'z':
+                    return quant1x::market::sz;
+                case ('b' << 8) | 'j':
+                    return quant1x::market::bj;
+                default:
+                    return quant1x::market::unknown;
+            }
+        }
+
+        [[nodiscard]] constexpr quant1x::board board() const noexcept {
+            switch (market()) {
+                case quant1x::market::sh:
+                    if (starts_with("sh688") || starts_with("sh689")) return quant1x::board::star;
+                    if (starts_with("sh60")) return quant1x::board::main;
+                    if (starts_with("sh000")) return quant1x::board::index;
+                    if (starts_with("sh5")) return quant1x::board::fund;
+                    break;
+                case quant1x::market::sz:
+                    if (starts_with("sz300") || starts_with("sz301")) return quant1x::board::chinext;
+                    if (starts_with("sz00")) return quant1x::board::main;
+                    if (starts_with("sz399")) return quant1x::board::index;
+                    if (starts_with("sz15") || starts_with("sz16")) return quant1x::board::fund;
+                    break;
+                case quant1x::market::bj:
+                    return quant1x::board::bse;
+                default:
+                    break;
+            }
+            return quant1x::board::unknown;
+        }
+
+        // 6位数字代码, 写入 out, 返回写入的字节数
+        size_t symbol(char* out) const noexcept {
+            for (size_t i = 0; i < 6; ++i) {
+                out[i] = static_cast<char>(value_ >> (8 * (5 - i)));
+            }
+            return 6;
+        }
+
+        // 写入8个字符, 不追加 '\0'
+        void to_chars(char* out) const noexcept {
+            for (size_t i = 0; i < length; ++i) {
+                out[i] = static_cast<char>(value_ >> (8 * (length - 1 - i)));
+            }
+        }
+
+        [[nodiscard]] std::string to_string() const {
+            std::string s(length, '\0');
+            to_chars(s.data());
+            return s;
+        }
+
+        friend constexpr bool operator==(security_code, security_code) noexcept = default;
+        friend constexpr auto operator<=>(security_code, security_code) noexcept = default;
+    };
+
+    /**
+     * @brief 批量解析证券代码
+     * @details 先把每个代码的8个字节收集到连续缓冲区, 再按 SIMD 宽度一次校验多个代码的字符类别
+     * @param codes 输入
+     * @param out 输出, 至少 codes.size() 个元素, 非法的代码输出无效值
+     * @return 合法代码的个数
+     */
+    size_t parse_security_codes(std::span<const std::string_view> codes, std::span<security_code> out) noexcept;
+
+    /**
+     * @brief 批量校验8字节一组的原始代码, 例如定长记录中的代码字段
+     * @param raw 长度为 8 * valid.size() 的字符数组
+     * @param valid 每个代码是否合法
+     * @return 合法代码的个数
+     */
+    size_t validate_security_codes(std::span<const char> raw, std::span<bool> valid) noexcept;
+
+}  // namespace quant1x
+
+template <>
+struct std::hash<quant1x::security_code> {
+    size_t operator()(quant1x::security_code code) const noexcept {
+        // murmur3 的 fmix64, 打包值的低位是数字, 直接取模分布不均
+        uint64_t h = code.value();
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+};
+
+#endif  // QUANT1X_STD_SECURITY_CODE_H
@@ -1,7 +1,181 @@
 #include "strings.h"
 
+#include <bit>
+#include <fmt/compile.h>
+#include <thread>
+#include <tsl/robin_set.h>
+#include <xsimd/xsimd.hpp>
+
 namespace strings {
 
+    namespace {
+
+        /**
+         * @brief 查找 str 中全部的 delimiter, 每找到一个调用一次 on_match(pos)
+         * @details 每次比较一个 SIMD 宽度的字节块, movemask 得到匹配位图后逐位取出, 尾部走标量
+         */
+        template <typename F>
+        inline void scan_char(std::string_view str, char delimiter, F&& on_match) {
+            using batch = xsimd::batch<uint8_t>;
+            constexpr size_t width = batch::size;
+            const auto* p = reinterpret_cast<const uint8_t*>(str.data());
+            const size_t n = str.size();
+            const batch needle(static_cast<uint8_t>(delimiter));
+            size_t i = 0;
+            for (; i + width <= n; i += width) {
+                uint64_t mask = (batch::load_unaligned(p + i) == needle).mask();
+                while (mask != 0) {
+                    on_match(i + static_cast<size_t>(std::countr_zero(mask)));
+                    mask &= mask - 1;
+                }
+            }
+            for (; i < n; ++i) {
+                if (p[i] == static_cast<uint8_t>(delimiter)) {
+                    on_match(i);
+                }
+            }
+        }
+
+        // 按字符分割, 每个 token 去除两端空白后交给 emit
+        template <typename Emit>
+        inline void split_char(std::string_view str, char delimiter, bool ignoreEmpty, Emit&& emit) {
+            if (str.empty()) return;
+            size_t start = 0;
+            auto push = [&](size_t end) {
+                std::string_view token = trim_view(str.substr(start, end - start));
+                if (!ignoreEmpty || !token.empty()) {
+                    emit(token);
+                }
+            };
+            scan_char(str, delimiter, [&](size_t pos) {
+                push(pos);
+                start = pos + 1;
+            });
+            push(str.size());
+        }
+
+        /**
+         * @brief ASCII 大小写转换内核
+         * @details 字母范围判断用一次无符号比较: (c - first) < 26, 命中的字节翻转 0x20 位
+         * @param first 'A' 转小写, 'a' 转大写
+         */
+        inline void convert_case(const char* src, char* dst, size_t n, char first) noexcept {
+            using batch = xsimd::batch<uint8_t>;
+            constexpr size_t width = batch::size;
+            const auto* in  = reinterpret_cast<const uint8_t*>(src);
+            auto*       out = reinterpret_cast<uint8_t*>(dst);
+            const batch base(static_cast<uint8_t>(first));
+            const batch letters(uint8_t(26));
+            const batch flip(uint8_t(0x20));
+            size_t i = 0;
+            for (; i + width <= n; i += width) {
+                const batch c    = batch::load_unaligned(in + i);
+                const auto  hit  = (c - base) < letters;
+                const batch conv = xsimd::select(hit, c ^ flip, c);
+                conv.store_unaligned(out + i);
+            }
+            for (; i < n; ++i) {
+                const uint8_t c = in[i];
+                out[i] = static_cast<uint8_t>(static_cast<uint8_t>(c - first) < 26 ? c ^ 0x20 : c);
+            }
+        }
+
+        // 4位数值转十六进制字符: n + '0', 大于9的再加上字母偏移, 比较+选择代替查表
+        template <typename B>
+        inline B hex_digits(const B& nibble, const B& alpha) noexcept {
+            return nibble + B(uint8_t('0')) + xsimd::select(nibble > B(uint8_t(9)), alpha, B(uint8_t(0)));
+        }
+
+        /**
+         * @brief 十六进制字符转4位数值, 非法字符的位置在 invalid 中置位
+         * @details '0'~'9' 用 c - '0' < 10 判断, 字母先 | 0x20 统一成小写再判断 c - 'a' < 6
+         */
+        template <typename B>
+        inline B hex_values(const B& c, typename B::batch_bool_type& invalid) noexcept {
+            const B    digit = c - B(uint8_t('0'));
+            const B    alpha = (c | B(uint8_t(0x20))) - B(uint8_t('a'));
+            const auto is_digit = digit < B(uint8_t(10));
+            const auto is_alpha = alpha < B(uint8_t(6));
+            invalid = !(is_digit || is_alpha);
+            return xsimd::select(is_digit, digit, alpha + B(uint8_t(10)));
+        }
+
+        // 偶数下标的字节依次移到前半部分, 用于把16位通道收窄为字节
+        struct even_bytes {
+            static constexpr uint8_t get(size_t i, size_t n) noexcept {
+                return static_cast<uint8_t>(2 * (i % (n / 2)));
+            }
+        };
+
+        inline int hex_value(uint8_t c) noexcept {
+            if (static_cast<uint8_t>(c - '0') < 10) return c - '0';
+            c |= 0x20;
+            if (static_cast<uint8_t>(c - 'a') < 6) return c - 'a' + 10;
+            return -1;
+        }
+
+        /**
+         * @brief 标记每个字符串是否第一次出现
+         * @details 单线程时一次遍历, 哈希集合中只存视图. 多线程时先分段并行计算哈希值, 再按哈希值分片:
+         * 每个线程按原顺序扫描全部哈希值, 只处理属于自己分片的元素, 同一字符串必然落在同一分片,
+         * 所以"第一次出现"的判断与单线程一致, 线程之间不需要同步
+         * @param at at(i) 返回第 i 个字符串的视图
+         */
+        template <typename At>
+        std::vector<char> first_occurrences(size_t n, At&& at, size_t threads) {
+            std::vector<char> keep(n, 0);
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            if (threads <= 1 || n < unique_parallel_threshold) {
+                tsl::robin_set<std::string_view> seen;
+                seen.reserve(n);
+                for (size_t i = 0; i < n; ++i) {
+                    keep[i] = seen.insert(at(i)).second;
+                }
+                return keep;
+            }
+            std::vector<size_t> hashes(n);
+            auto run = [threads](auto&& work) {
+                std::vector<std::thread> workers;
+                workers.reserve(threads - 1);
+                for (size_t t = 1; t < threads; ++t) {
+                    workers.emplace_back(work, t);
+                }
+                work(size_t(0));
+                for (auto& w : workers) {
+                    w.join();
+                }
+            };
+            run([&](size_t t) {
+                const size_t begin = n * t / threads;
+                const size_t end   = n * (t + 1) / threads;
+                for (size_t i = begin; i < end; ++i) {
+                    hashes[i] = std::hash<std::string_view>{}(at(i));
+                }
+            });
+            run([&](size_t t) {
+                tsl::robin_set<std::string_view> seen;
+                seen.reserve(n / threads * 2);
+                for (size_t i = 0; i < n; ++i) {
+                    if (hashes[i] % threads == t) {
+                        keep[i] = seen.insert(at(i)).second;
+                    }
+                }
+            });
+            return keep;
+        }
+
+    }  // namespace
+
+    void to_lower_ascii(const char* src, char* dst, size_t n) noexcept {
+        convert_case(src, dst, n, 'A');
+    }
+
+    void to_upper_ascii(const char* src, char* dst, size_t n) noexcept {
+        convert_case(src, dst, n, 'a');
+    }
+
     bool is_whitespace(char ch) {
         return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
     }
@@ -61,27 +235,31 @@ namespace strings {
 
         // 预分配内存 (+1 是为了最后一个token)
         tokens.reserve(std::count(str.begin(), str.end(), delimiter) + 1);
+        split_char(str, delimiter, ignoreEmpty, [&tokens](std::string_view token) { tokens.emplace_back(token); });
+        return tokens;
+    }
 
-        size_t start = 0;
-        size_t end = 0;
-
-        while (end != std::string::npos) {
-            end = str.find(delimiter, start);
+    std::vector<std::string_view> split_view(std::string_view str, char delimiter, bool ignoreEmpty) {
+        std::vector<std::string_view> tokens;
+        split_view(str, delimiter, tokens, ignoreEmpty);
+        return tokens;
+    }
 
-            // 获取当前token的视图
-            std::string token = str.substr(start, end - start);
-            // 去除前后空白
-            token = trim(token);
+    size_t split_view(std::string_view str, char delimiter, std::vector<std::string_view>& out, bool ignoreEmpty) {
+        out.clear();
+        split_char(str, delimiter, ignoreEmpty, [&out](std::string_view token) { out.push_back(token); });
+        return out.size();
+    }
 
-            if (!ignoreEmpty || !token.empty()) {
-                // 只在需要时才创建std::string
-                tokens.emplace_back(token);
+    size_t split_view(std::string_view str, char delimiter, std::span<std::string_view> out, bool ignoreEmpty) {
+        size_t count = 0;
+        split_char(str, delimiter, ignoreEmpty, [&](std::string_view token) {
+            if (count < out.size()) {
+                out[count] = token;
             }
-
-            start = end + (end != std::string::npos);
-        }
-
-        return tokens;
+            ++count;
+        });
+        return count;
     }
 
     std::vector<std::string> split(const std::string& str, const std::string& delimiter, bool ignoreEmpty)
@@ -128,72 +306,280 @@ namespace strings {
         return arr;
     }
 
-    // 将 string 的每个字节转为十六进制字符串
-    std::string to_hex_string(const std::string& input) {
-        std::stringstream ss;
-        for (unsigned char c : input) {
-            ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(static_cast<unsigned char>(c));
+    std::vector<std::string> unique_stable(const std::vector<std::string>& arr, size_t threads) {
+        const std::vector<char> keep = first_occurrences(arr.size(), [&](size_t i) { return std::string_view(arr[i]); }, threads);
+        std::vector<std::string> result;
+        result.reserve(static_cast<size_t>(std::count(keep.begin(), keep.end(), 1)));
+        for (size_t i = 0; i < arr.size(); ++i) {
+            if (keep[i]) {
+                result.push_back(arr[i]);
+            }
         }
-        return ss.str();
+        return result;
     }
 
-    // 将字节数组转换为十六进制字符串（默认大写）
-    std::string bytesToHex(const std::vector<uint8_t>& bytes, bool uppercase) {
-        std::string hex;
-        hex.reserve(bytes.size() * 2); // 预分配内存，避免多次扩容
+    size_t unique_inplace(std::vector<std::string>& arr, size_t threads) {
+        // 先标记再搬移, 标记期间哈希表中的视图指向未移动的元素
+        const std::vector<char> keep = first_occurrences(arr.size(), [&](size_t i) { return std::string_view(arr[i]); }, threads);
+        size_t w = 0;
+        for (size_t i = 0; i < arr.size(); ++i) {
+            if (keep[i]) {
+                if (w != i) {
+                    arr[w] = std::move(arr[i]);
+                }
+                ++w;
+            }
+        }
+        const size_t removed = arr.size() - w;
+        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(w), arr.end());
+        return removed;
+    }
+
+    std::vector<std::string_view> unique_view(std::span<const std::string_view> arr, size_t threads) {
+        const std::vector<char> keep = first_occurrences(arr.size(), [&](size_t i) { return arr[i]; }, threads);
+        std::vector<std::string_view> result;
+        result.reserve(static_cast<size_t>(std::count(keep.begin(), keep.end(), 1)));
+        for (size_t i = 0; i < arr.size(); ++i) {
+            if (keep[i]) {
+                result.push_back(arr[i]);
+            }
+        }
+        return result;
+    }
 
-        // 十六进制字符表（大写或小写）
-        const char* hex_chars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    void hex_encode(std::span<const uint8_t> bytes, char* out, bool uppercase) noexcept {
+        using batch = xsimd::batch<uint8_t>;
+        constexpr size_t width = batch::size;
+        const uint8_t* in  = bytes.data();
+        auto*          dst = reinterpret_cast<uint8_t*>(out);
+        const size_t   n   = bytes.size();
+        const uint8_t  alpha = uppercase ? uint8_t('A' - '0' - 10) : uint8_t('a' - '0' - 10);
+        const batch    valpha(alpha);
+        const batch    low_mask(uint8_t(0x0F));
+        size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const batch b  = batch::load_unaligned(in + i);
+            const batch hi = hex_digits((b >> 4) & low_mask, valpha);
+            const batch lo = hex_digits(b & low_mask, valpha);
+            // 交错高低位: hi0 lo0 hi1 lo1 ...
+            xsimd::zip_lo(hi, lo).store_unaligned(dst + 2 * i);
+            xsimd::zip_hi(hi, lo).store_unaligned(dst + 2 * i + width);
+        }
+        const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+        for (; i < n; ++i) {
+            dst[2 * i]     = static_cast<uint8_t>(digits[in[i] >> 4]);
+            dst[2 * i + 1] = static_cast<uint8_t>(digits[in[i] & 0x0F]);
+        }
+    }
 
-        for (uint8_t byte : bytes) {
-            // 提取高4位和低4位，并映射到对应的字符
-            hex.push_back(hex_chars[byte >> 4]);    // 高四位
-            hex.push_back(hex_chars[byte & 0x0F]);  // 低四位
+    size_t hex_decode(std::string_view hex, std::span<uint8_t> out, std::error_code& ec) noexcept {
+        ec.clear();
+        if (hex.size() % 2 != 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return 0;
+        }
+        const size_t n = hex.size() / 2;
+        if (out.size() < n) {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return 0;
+        }
+        const auto* in  = reinterpret_cast<const uint8_t*>(hex.data());
+        uint8_t*    dst = out.data();
+        size_t i = 0;
+#if ENDIAN_LITTLE
+        using batch = xsimd::batch<uint8_t>;
+        using wide  = xsimd::batch<uint16_t>;
+        constexpr size_t width = batch::size;
+        // 每轮处理 width 个字符, 得到 width/2 个字节. 整块写出 width 个字节, 后半部分由下一轮覆盖,
+        // 所以要求输出至少还剩 width 个字节
+        for (; 2 * i + 2 * width <= hex.size(); i += width / 2) {
+            batch::batch_bool_type invalid;
+            const batch v = hex_values(batch::load_unaligned(in + 2 * i), invalid);
+            if (xsimd::any(invalid)) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return i + static_cast<size_t>(std::countr_zero(invalid.mask())) / 2;
+            }
+            // 每个16位通道的低字节是高4位, 高字节是低4位, 合并后结果在通道的低字节
+            const wide w = xsimd::bitwise_cast<uint16_t>(v);
+            const wide b = ((w & wide(uint16_t(0x0F))) << 4) | (w >> 8);
+            const batch packed = xsimd::swizzle(xsimd::bitwise_cast<uint8_t>(b),
+                                                xsimd::make_batch_constant<uint8_t, even_bytes, batch::arch_type>());
+            packed.store_unaligned(dst + i);
+        }
+#endif
+        for (; i < n; ++i) {
+            const int high = hex_value(in[2 * i]);
+            const int low  = hex_value(in[2 * i + 1]);
+            if (high < 0 || low < 0) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return i;
+            }
+            dst[i] = static_cast<uint8_t>((high << 4) | low);
         }
+        return n;
+    }
+
+    // 将 string 的每个字节转为十六进制字符串
+    std::string to_hex_string(const std::string& input) {
+        std::string hex(input.size() * 2, '\0');
+        hex_encode(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(input.data()), input.size()), hex.data(), false);
+        return hex;
+    }
+
+    // 将字节数组转换为十六进制字符串（默认大写）
+    std::string bytesToHex(const std::vector<uint8_t>& bytes, bool uppercase) {
+        std::string hex(bytes.size() * 2, '\0');
+        hex_encode(bytes, hex.data(), uppercase);
         return hex;
     }
 
     std::vector<uint8_t> hexToBytes(const std::string& hex) {
-        std::vector<uint8_t> bytes;
         // 检查字符串长度是否为偶数
         if (hex.length() % 2 != 0) {
             throw std::invalid_argument("Hex string must have even length");
         }
+        std::vector<uint8_t> bytes(hex.length() / 2);
+        std::error_code ec;
+        hex_decode(hex, bytes, ec);
+        if (ec) {
+            throw std::invalid_argument("Invalid hex character detected");
+        }
+        return bytes;
+    }
 
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            char highChar = hex[i];
-            char lowChar = hex[i + 1];
+    std::string replace_all(std::string str, const std::string &from, const std::string &to) {
+        if (from.empty()) {
+            return str;
+        }
+        // 第一遍统计匹配次数, 第二遍写入
+        size_t matches = 0;
+        for (size_t pos = str.find(from); pos != std::string::npos; pos = str.find(from, pos + from.size())) {
+            ++matches;
+        }
+        if (matches == 0) {
+            return str;
+        }
+        std::string result(str.size() - matches * from.size() + matches * to.size(), '\0');
+        char* out = result.data();
+        size_t last = 0;
+        for (size_t pos = str.find(from); pos != std::string::npos; pos = str.find(from, last)) {
+            out = std::copy(str.data() + last, str.data() + pos, out);
+            out = std::copy(to.begin(), to.end(), out);
+            last = pos + from.size();
+        }
+        std::copy(str.data() + last, str.data() + str.size(), out);
+        return result;
+    }
 
-            // 验证是否为有效十六进制字符
-            if (!isxdigit(highChar) || !isxdigit(lowChar)) {
-                throw std::invalid_argument("Invalid hex character detected");
+    replacer::replacer(std::span<const pair> pairs) {
+        rules_.reserve(pairs.size());
+        for (const auto& [from, to] : pairs) {
+            if (!from.empty()) {
+                rules_.push_back({std::string(from), std::string(to)});
             }
+        }
+        // 按首字节分桶(CSR 布局), 稳定计数排序保持参数顺序即优先级
+        for (const auto& r : rules_) {
+            const auto c = static_cast<uint8_t>(r.from[0]);
+            first_[c] = true;
+            ++bucket_start_[c + 1];
+        }
+        for (size_t c = 0; c < 256; ++c) {
+            bucket_start_[c + 1] += bucket_start_[c];
+        }
+        bucket_.resize(rules_.size());
+        std::array<uint32_t, 256> fill{};
+        for (size_t i = 0; i < rules_.size(); ++i) {
+            const auto c = static_cast<uint8_t>(rules_[i].from[0]);
+            bucket_[bucket_start_[c] + fill[c]++] = static_cast<uint32_t>(i);
+        }
+        for (size_t c = 0; c < 256; ++c) {
+            if (first_[c]) {
+                if (needle_count_ < needles_.size()) {
+                    needles_[needle_count_] = static_cast<char>(c);
+                }
+                ++needle_count_;
+            }
+        }
+    }
 
-            // 转换为大写统一处理
-            highChar = toupper(highChar);
-            lowChar = toupper(lowChar);
-
-            // 计算高四位和低四位的值
-            unsigned char high = (highChar >= 'A') ? (highChar - 'A' + 10) : (highChar - '0');
-            unsigned char low = (lowChar >= 'A') ? (lowChar - 'A' + 10) : (lowChar - '0');
-
-            // 合并为一个字节
-            bytes.push_back((high << 4) | low);
+    size_t replacer::next_candidate(std::string_view str, size_t pos) const noexcept {
+        const auto*  p = reinterpret_cast<const uint8_t*>(str.data());
+        const size_t n = str.size();
+        if (needle_count_ <= needles_.size()) {
+            using batch = xsimd::batch<uint8_t>;
+            constexpr size_t width = batch::size;
+            for (; pos + width <= n; pos += width) {
+                const batch block = batch::load_unaligned(p + pos);
+                auto hit = block == batch(static_cast<uint8_t>(needles_[0]));
+                for (size_t k = 1; k < needle_count_; ++k) {
+                    hit = hit || (block == batch(static_cast<uint8_t>(needles_[k])));
+                }
+                const uint64_t mask = hit.mask();
+                if (mask != 0) {
+                    return pos + static_cast<size_t>(std::countr_zero(mask));
+                }
+            }
         }
+        for (; pos < n; ++pos) {
+            if (first_[p[pos]]) {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
 
-        return bytes;
+    size_t replacer::next_match(std::string_view str, size_t pos, const rule*& matched) const noexcept {
+        if (rules_.empty()) {
+            return std::string_view::npos;
+        }
+        while ((pos = next_candidate(str, pos)) != std::string_view::npos) {
+            const auto c = static_cast<uint8_t>(str[pos]);
+            const std::string_view rest = str.substr(pos);
+            for (uint32_t k = bucket_start_[c]; k < bucket_start_[c + 1]; ++k) {
+                const rule& r = rules_[bucket_[k]];
+                if (rest.starts_with(r.from)) {
+                    matched = &r;
+                    return pos;
+                }
+            }
+            ++pos;
+        }
+        return std::string_view::npos;
     }
 
-    std::string replace_all(std::string str, const std::string &from, const std::string &to) {
-        size_t pos = 0;
-        auto from_size = from.size();
-        auto to_size = to.size();
+    size_t replacer::count(std::string_view str) const noexcept {
+        size_t      matches = 0;
+        const rule* r       = nullptr;
+        for (size_t pos = next_match(str, 0, r); pos != std::string_view::npos; pos = next_match(str, pos + r->from.size(), r)) {
+            ++matches;
+        }
+        return matches;
+    }
 
-        while ((pos = str.find(from, pos)) != std::string::npos) {
-            str.replace(pos, from_size, to);
-            pos += to_size; // 防止无限循环
+    void replacer::replace_into(std::string_view str, std::string& out) const {
+        // 第一遍计算输出长度
+        size_t      size = str.size();
+        const rule* r    = nullptr;
+        for (size_t pos = next_match(str, 0, r); pos != std::string_view::npos; pos = next_match(str, pos + r->from.size(), r)) {
+            size = size - r->from.size() + r->to.size();
+        }
+        out.resize(size);
+        // 第二遍写入
+        char*  dst  = out.data();
+        size_t last = 0;
+        for (size_t pos = next_match(str, 0, r); pos != std::string_view::npos; pos = next_match(str, last, r)) {
+            dst  = std::copy(str.data() + last, str.data() + pos, dst);
+            dst  = std::copy(r->to.begin(), r->to.end(), dst);
+            last = pos + r->from.size();
         }
-        return str;
+        std::copy(str.data() + last, str.data() + str.size(), dst);
+    }
+
+    std::string replacer::replace(std::string_view str) const {
+        std::string out;
+        replace_into(str, out);
+        return out;
     }
 
     // =============================================================================
@@ -292,84 +678,211 @@ namespace strings {
     }
 
     std::string toString(float value) {
-        return std::to_string(value);
+        return to_string(value);
     }
 
     std::string toString(double value) {
-        return std::to_string(value);
+        return to_string(value);
     }
 
     std::string toString(bool value) {
         return value ? "true" : "false";
     }
 
+    size_t format_shortest(double value, char* out) noexcept {
+        return static_cast<size_t>(fmt::format_to(out, FMT_COMPILE("{}"), value) - out);
+    }
+
+    size_t format_shortest(float value, char* out) noexcept {
+        return static_cast<size_t>(fmt::format_to(out, FMT_COMPILE("{}"), value) - out);
+    }
+
+    size_t format_fixed(double value, int precision, std::span<char> out, std::error_code& ec) noexcept {
+        ec.clear();
+        if (precision < 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return 0;
+        }
+        const auto [ptr, err] = std::to_chars(out.data(), out.data() + out.size(), value, std::chars_format::fixed, precision);
+        if (err != std::errc()) {
+            ec = std::make_error_code(err);
+            return 0;
+        }
+        return static_cast<size_t>(ptr - out.data());
+    }
+
+    template <typename T>
+    void float_column::append_values(std::span<const T> values) {
+        // 常见的数值按 float_chars_max + precision 预留, 定点格式遇到超大数值时再按最坏情况扩容
+        const size_t guess = float_chars_max + static_cast<size_t>(std::max(precision_, 0));
+        const size_t worst = std::numeric_limits<double>::max_exponent10 + 3 + static_cast<size_t>(std::max(precision_, 0));
+        size_t       used  = chars_.size();
+        chars_.resize(used + values.size() * guess);
+        ends_.reserve(ends_.size() + values.size());
+        std::error_code ec;
+        for (const T value : values) {
+            if (chars_.size() - used < guess) {
+                chars_.resize(std::max(chars_.size() * 2, used + guess));
+            }
+            if (precision_ < 0) {
+                used += format_shortest(value, chars_.data() + used);
+            } else {
+                size_t n = format_fixed(value, precision_, std::span<char>(chars_.data() + used, chars_.size() - used), ec);
+                if (ec) {
+                    chars_.resize(std::max(chars_.size() * 2, used + worst));
+                    n = format_fixed(value, precision_, std::span<char>(chars_.data() + used, chars_.size() - used), ec);
+                }
+                used += n;
+            }
+            ends_.push_back(used);
+        }
+        chars_.resize(used);
+    }
+
+    void float_column::append(std::span<const double> values) {
+        append_values(values);
+    }
+
+    void float_column::append(std::span<const float> values) {
+        append_values(values);
+    }
+
+    void write_rows(std::span<const float_column> columns, std::string& out, char delimiter) {
+        if (columns.empty()) {
+            return;
+        }
+        size_t rows  = columns[0].size();
+        size_t bytes = 0;
+        for (const auto& column : columns) {
+            rows = std::min(rows, column.size());
+        }
+        for (const auto& column : columns) {
+            bytes += rows == 0 ? 0 : column[rows - 1].data() + column[rows - 1].size() - column[0].data();
+        }
+        out.reserve(out.size() + bytes + rows * columns.size());
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t c = 0; c < columns.size(); ++c) {
+                if (c != 0) {
+                    out.push_back(delimiter);
+                }
+                out.append(columns[c][row]);
+            }
+            out.push_back('\n');
+        }
+    }
+
     // 内部实现命名空间
     namespace detail {
-        std::string camel_case_impl(const std::string& str, bool upper_first) {
-            std::string s = trim(str);
-            if (s.empty()) return s;
-            
-            std::string result;
-            result.reserve(s.length());
-            
-            string_iter(s, [&](char prev, char curr, char /*next*/) {
+        size_t camel_case_to(std::string_view str, bool upper_first, char* out) noexcept {
+            const std::string_view s = trim_view(str);
+            char* dst  = out;
+            char  prev = 0;
+            for (char curr : s) {
                 if (!is_delimiter(curr)) {
                     if (is_delimiter(prev) || (upper_first && prev == 0)) {
-                        result += to_upper(curr);
+                        *dst++ = to_upper(curr);
                     } else if (is_lower(prev)) {
-                        result += curr;
+                        *dst++ = curr;
                     } else {
-                        result += to_lower(curr);
+                        *dst++ = to_lower(curr);
                     }
                 }
-            });
-            
-            return result;
+                prev = curr;
+            }
+            return static_cast<size_t>(dst - out);
         }
 
-        std::string delimiter_case_impl(const std::string& str, char delimiter, bool upper_case) {
-            std::string s = trim(str);
-            if (s.empty()) return s;
-            
-            std::string result;
-            result.reserve(s.length() + 3);
-            
+        size_t delimiter_case_to(std::string_view str, char delimiter, bool upper_case, char* out) noexcept {
+            const std::string_view s = trim_view(str);
+            if (s.empty()) return 0;
+
+            char* dst = out;
             auto adjust_case = [upper_case](char c) { return upper_case ? to_upper(c) : to_lower(c); };
-            
+
             char prev = 0;
             char curr = 0;
-            
+
             for (char next : s) {
                 if (is_delimiter(curr)) {
                     if (!is_delimiter(prev) && prev != 0) {
-                        result += delimiter;
+                        *dst++ = delimiter;
                     }
                 } else if (is_upper(curr)) {
                     if (is_lower(prev) || (is_upper(prev) && is_lower(next))) {
-                        result += delimiter;
+                        *dst++ = delimiter;
                     }
-                    result += adjust_case(curr);
+                    *dst++ = adjust_case(curr);
                 } else if (curr != 0) {
-                    result += adjust_case(curr);
+                    *dst++ = adjust_case(curr);
                 }
                 prev = curr;
                 curr = next;
             }
-            
+
             // 处理最后一个字符
-            if (!s.empty()) {
-                if (is_upper(curr) && is_lower(prev) && prev != 0) {
-                    result += delimiter;
-                }
-                if (!is_delimiter(curr)) {
-                    result += adjust_case(curr);
-                }
+            if (is_upper(curr) && is_lower(prev) && prev != 0) {
+                *dst++ = delimiter;
             }
-            
+            if (!is_delimiter(curr)) {
+                *dst++ = adjust_case(curr);
+            }
+            return static_cast<size_t>(dst - out);
+        }
+
+        std::string camel_case_impl(const std::string& str, bool upper_first) {
+            std::string result(str.size(), '\0');
+            result.resize(camel_case_to(str, upper_first, result.data()));
+            return result;
+        }
+
+        std::string delimiter_case_impl(const std::string& str, char delimiter, bool upper_case) {
+            std::string result(case_capacity(str.size()), '\0');
+            result.resize(delimiter_case_to(str, delimiter, upper_case, result.data()));
             return result;
         }
     }
 
+    size_t convert_case_to(std::string_view str, identifier_case style, char* out) noexcept {
+        switch (style) {
+            case identifier_case::upper_camel:
+                return detail::camel_case_to(str, true, out);
+            case identifier_case::lower_camel:
+                return detail::camel_case_to(str, false, out);
+            case identifier_case::snake:
+                return detail::delimiter_case_to(str, '_', false, out);
+            case identifier_case::upper_snake:
+                return detail::delimiter_case_to(str, '_', true, out);
+            case identifier_case::kebab:
+                return detail::delimiter_case_to(str, '-', false, out);
+            case identifier_case::upper_kebab:
+                return detail::delimiter_case_to(str, '-', true, out);
+        }
+        return 0;
+    }
+
+    std::string_view case_converter::convert(std::string_view name) {
+        if (auto it = cache_.find(name); it != cache_.end()) {
+            return it->second;
+        }
+        buffer_.resize(case_capacity(name.size()));
+        const size_t n = convert_case_to(name, style_, buffer_.data());
+        auto [it, inserted] = cache_.emplace(std::string(name), std::string(buffer_.data(), n));
+        return it->second;
+    }
+
+    void case_converter::convert(std::span<const std::string_view> names, std::span<std::string_view> out) {
+        const size_t n = std::min(names.size(), out.size());
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = convert(names[i]);
+        }
+    }
+
+    std::vector<std::string_view> case_converter::convert(std::span<const std::string_view> names) {
+        std::vector<std::string_view> out(names.size());
+        convert(names, out);
+        return out;
+    }
+
     // CamelCase 转换函数实现
     std::string to_camel_case(const std::string& str) {
         // 兼容原有的 ToCamelCase 逻辑
@@ -423,30 +936,75 @@ namespace strings {
         if (str.empty() || prefixes.empty()) {
             return false;
         }
-        
-        for (const auto& prefix : prefixes) {
-            if (str.length() >= prefix.length() && 
-                str.substr(0, prefix.length()) == prefix) {
-                return true;
-            }
-        }
-        
-        return false;
+        return startsWith(str, prefixes);
     }
 
     bool ends_with(const std::string& str, const std::vector<std::string>& suffixes) {
         if (str.empty() || suffixes.empty()) {
             return false;
         }
-        
-        for (const auto& suffix : suffixes) {
-            if (str.length() >= suffix.length() && 
-                str.substr(str.length() - suffix.length()) == suffix) {
-                return true;
+        return endsWith(str, suffixes);
+    }
+
+    affix_matcher::affix_matcher(std::span<const std::string_view> patterns, mode m) : mode_(m) {
+        build(patterns);
+    }
+
+    affix_matcher::affix_matcher(const std::vector<std::string>& patterns, mode m) : mode_(m) {
+        std::vector<std::string_view> views(patterns.begin(), patterns.end());
+        build(views);
+    }
+
+    void affix_matcher::build(std::span<const std::string_view> patterns) {
+        // 1. 给模式中出现的字节分配列号
+        uint16_t columns = 0;
+        for (std::string_view p : patterns) {
+            for (char c : p) {
+                uint16_t& cls = classes_[static_cast<uint8_t>(c)];
+                if (cls == 0) {
+                    cls = ++columns;
+                }
             }
         }
-        
-        return false;
+        stride_ = size_t(columns) + 1;
+        // 2. 插入字典树, 节点按需追加一行转移表
+        next_.assign(stride_, 0);
+        accept_.assign(1, npos);
+        patterns_.reserve(patterns.size());
+        for (size_t index = 0; index < patterns.size(); ++index) {
+            const std::string_view p = patterns[index];
+            patterns_.emplace_back(p);
+            int32_t node = 0;
+            const size_t n = p.size();
+            for (size_t i = 0; i < n; ++i) {
+                const char c = mode_ == mode::prefix ? p[i] : p[n - 1 - i];
+                int32_t& slot = next_[static_cast<size_t>(node) * stride_ + classes_[static_cast<uint8_t>(c)]];
+                if (slot == 0) {
+                    // 先写入子节点编号再扩容, 扩容会使 slot 失效
+                    node = slot = static_cast<int32_t>(accept_.size());
+                    next_.resize(next_.size() + stride_, 0);
+                    accept_.push_back(npos);
+                } else {
+                    node = slot;
+                }
+            }
+            if (accept_[node] == npos) {
+                accept_[node] = index;
+            }
+        }
+    }
+
+    void affix_matcher::classify(std::span<const std::string_view> inputs, std::span<size_t> out) const noexcept {
+        const size_t n = std::min(inputs.size(), out.size());
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = match(inputs[i]);
+        }
+    }
+
+    std::vector<size_t> affix_matcher::classify(std::span<const std::string_view> inputs) const {
+        std::vector<size_t> out(inputs.size());
+        classify(inputs, out);
+        return out;
     }
 
     bool is_empty(const std::string& str) {
@@ -3,8 +3,18 @@
 #define QUANT1X_STD_STRINGS_H 1
 
 #include "base.h"
+#include <array>
+#include <charconv>
+#include <cmath>
 #include <functional>
+#include <ranges>
+#include <span>
 #include <sstream>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+#include <fmt/format.h>
 
 namespace strings {
 
@@ -28,33 +38,283 @@ namespace strings {
         return from(start, N);
     }
 
-    // 将字符串转为 T 类型，失败则返回默认值
+    // 去掉字符串两端的空白字符
+    std::string trim(const std::string& str);
+
+    std::string_view trim_view(std::string_view str);
+
+    namespace detail {
+
+        // 可以直接交给 std::from_chars 的数值类型, 字符类型与 istream 一样按字符读取, 不在此列
+        template <typename T>
+        constexpr bool is_from_chars_v =
+            (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+             !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> && !std::is_same_v<T, wchar_t> &&
+             !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>) ||
+            std::is_floating_point_v<T>;
+
+        /**
+         * @brief 不依赖 locale 的数值解析, 基于 std::from_chars
+         * @details 与 istream 的行为保持一致: 跳过前导空白, 允许一个 '+' 号; 不接受 inf/nan;
+         * 无符号类型允许 '-' 号, 结果按模回绕(如 "-5" 解析为 unsigned 的 4294967291)
+         * @param str 输入
+         * @param value 输出, 失败时不修改
+         * @param used 成功时为消耗的字符数(含跳过的空白)
+         * @return 是否解析成功
+         */
+        template <typename T>
+        inline bool parse_number(std::string_view str, T& value, size_t& used) {
+            const char* first = str.data();
+            const char* last  = first + str.size();
+            while (first != last && is_whitespace(*first)) ++first;
+            if (first != last && *first == '+') {
+                ++first;
+                if (first != last && *first == '-') {
+                    return false;
+                }
+            }
+            bool negate = false;
+            if constexpr (std::is_unsigned_v<T>) {
+                if (first != last && *first == '-') {
+                    negate = true;
+                    ++first;
+                }
+            }
+            T v{};
+            const auto [ptr, ec] = std::from_chars(first, last, v);
+            if (ec != std::errc()) {
+                return false;
+            }
+            if constexpr (std::is_floating_point_v<T>) {
+                // 有限的输入溢出时 from_chars 报错, 这里得到非有限值只可能是 inf/nan 字面量
+                if (!std::isfinite(v)) {
+                    return false;
+                }
+            }
+            if (negate) {
+                v = static_cast<T>(T(0) - v);
+            }
+            value = v;
+            used  = static_cast<size_t>(ptr - str.data());
+            return true;
+        }
+
+    }  // namespace detail
+
+    // 将字符串转为 T 类型，失败则返回默认值; 与 istream 一样只要求前缀是合法的数值
     template<typename T>
-    inline T from_string(const std::string& s, T default_val= T{}) {
+    inline T from_string(std::string_view s, T default_val= T{}) {
         if (s.empty()) {
             return default_val;
         }
 
-        std::istringstream iss(s);
-        T val{};
-        iss >> val;
+        if constexpr (detail::is_from_chars_v<T>) {
+            T      val  = default_val;
+            size_t used = 0;
+            return detail::parse_number(s, val, used) ? val : default_val;
+        } else {
+            std::istringstream iss{std::string(s)};
+            T val{};
+            iss >> val;
+
+            // 如果转换失败，仍返回默认值
+            if (iss.fail() || iss.bad()) {
+                return default_val;
+            }
 
-        // 如果转换失败，仍返回默认值
-        if (iss.fail() || iss.bad()) {
-            return default_val;
+            return val;
         }
+    }
+
+    std::vector<std::string> split(const std::string& str, char delimiter, bool ignoreEmpty = false);
 
-        return val;
+    std::vector<std::string> split(const std::string& str, const std::string& delimiter, bool ignoreEmpty = false);
+
+    /**
+     * @brief 按字符分割, token 为指向 str 的视图, 不分配字符串
+     * @details 与 split 的语义一致: 去除每个 token 两端的空白, ignoreEmpty 时丢弃空 token.
+     * 分隔符用 SIMD 比较 + movemask 批量查找.
+     */
+    std::vector<std::string_view> split_view(std::string_view str, char delimiter, bool ignoreEmpty = false);
+
+    // 分割结果写入 out(先清空, 复用已有容量), 返回 token 个数
+    size_t split_view(std::string_view str, char delimiter, std::vector<std::string_view>& out, bool ignoreEmpty = false);
+
+    // 分割结果写入调用方提供的缓冲区, 最多写 out.size() 个, 返回 token 总数, 大于 out.size() 表示缓冲区不足
+    size_t split_view(std::string_view str, char delimiter, std::span<std::string_view> out, bool ignoreEmpty = false);
+
+    // ==============================
+    // 惰性分割
+    // ==============================
+
+    // 惰性分割的选项, 可以用 | 组合
+    enum class split_options : unsigned {
+        none       = 0,
+        trim       = 1,  ///< 去除 token 两端的空白
+        skip_empty = 2,  ///< 跳过空 token(在 trim 之后判断)
+    };
+
+    constexpr split_options operator|(split_options a, split_options b) {
+        return static_cast<split_options>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
     }
 
-    // 去掉字符串两端的空白字符
-    std::string trim(const std::string& str);
+    constexpr bool has_option(split_options options, split_options flag) {
+        return (static_cast<unsigned>(options) & static_cast<unsigned>(flag)) != 0;
+    }
 
-    std::string_view trim_view(std::string_view str);
+    // 字符集合分隔符, 其中任意一个字符都是分隔符
+    struct any_of {
+        std::string_view chars;
+    };
 
-    std::vector<std::string> split(const std::string& str, char delimiter, bool ignoreEmpty = false);
+    namespace detail {
 
-    std::vector<std::string> split(const std::string& str, const std::string& delimiter, bool ignoreEmpty = false);
+        // 分隔符的查找接口: find(str, from) 返回 {位置, 长度}, 没有找到时位置为 npos
+
+        struct char_delimiter {
+            char ch;
+
+            [[nodiscard]] std::pair<size_t, size_t> find(std::string_view str, size_t from) const {
+                const void* hit = std::memchr(str.data() + from, ch, str.size() - from);
+                if (hit == nullptr) {
+                    return {std::string_view::npos, 1};
+                }
+                return {static_cast<size_t>(static_cast<const char*>(hit) - str.data()), 1};
+            }
+        };
+
+        struct string_delimiter {
+            std::string_view text;
+
+            [[nodiscard]] std::pair<size_t, size_t> find(std::string_view str, size_t from) const {
+                // 空分隔符不分割
+                if (text.empty()) {
+                    return {std::string_view::npos, 0};
+                }
+                return {str.find(text, from), text.size()};
+            }
+        };
+
+        struct any_of_delimiter {
+            std::string_view chars;
+
+            [[nodiscard]] std::pair<size_t, size_t> find(std::string_view str, size_t from) const {
+                return {str.find_first_of(chars, from), 1};
+            }
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief 按需产生 token 的分割视图, 不分配内存
+     * @details token 是指向源字符串的 string_view, 源字符串必须比视图和迭代器活得长.
+     * 迭代器自带分隔符和选项, 不引用视图本身, 因此可以和 std::views 任意组合.
+     */
+    template <typename Delimiter>
+    class split_range : public std::ranges::view_interface<split_range<Delimiter>> {
+    public:
+        class iterator {
+        private:
+            std::string_view str_;
+            Delimiter        delimiter_{};
+            split_options    options_ = split_options::none;
+            std::string_view current_;
+            size_t           next_ = 0;     // 下一个 token 的起点, npos 表示已经是最后一个
+            bool             done_ = true;
+
+            void advance() {
+                while (true) {
+                    if (next_ == std::string_view::npos) {
+                        done_ = true;
+                        return;
+                    }
+                    const auto [pos, len] = delimiter_.find(str_, next_);
+                    std::string_view token;
+                    if (pos == std::string_view::npos) {
+                        token = str_.substr(next_);
+                        next_ = std::string_view::npos;
+                    } else {
+                        token = str_.substr(next_, pos - next_);
+                        next_ = pos + len;
+                    }
+                    if (has_option(options_, split_options::trim)) {
+                        token = trim_view(token);
+                    }
+                    if (has_option(options_, split_options::skip_empty) && token.empty()) {
+                        continue;
+                    }
+                    current_ = token;
+                    return;
+                }
+            }
+
+        public:
+            using iterator_concept  = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = std::string_view;
+            using difference_type   = std::ptrdiff_t;
+
+            iterator() = default;
+
+            iterator(std::string_view str, Delimiter delimiter, split_options options)
+                : str_(str), delimiter_(delimiter), options_(options), done_(str.empty()) {
+                if (!done_) {
+                    advance();
+                }
+            }
+
+            std::string_view operator*() const { return current_; }
+
+            iterator& operator++() {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                advance();
+                return tmp;
+            }
+
+            friend bool operator==(const iterator& a, const iterator& b) {
+                return a.done_ == b.done_ && (a.done_ || a.current_.data() == b.current_.data());
+            }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) {
+                return it.done_;
+            }
+        };
+
+        split_range() = default;
+
+        split_range(std::string_view str, Delimiter delimiter, split_options options)
+            : str_(str), delimiter_(delimiter), options_(options) {}
+
+        [[nodiscard]] iterator begin() const { return iterator(str_, delimiter_, options_); }
+
+        [[nodiscard]] std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    private:
+        std::string_view str_;
+        Delimiter        delimiter_{};
+        split_options    options_ = split_options::none;
+    };
+
+    // 空字符串不产生 token, 与 split 一致
+    inline split_range<detail::char_delimiter> split_lazy(std::string_view str, char delimiter,
+                                                          split_options options = split_options::none) {
+        return {str, detail::char_delimiter{delimiter}, options};
+    }
+
+    inline split_range<detail::string_delimiter> split_lazy(std::string_view str, std::string_view delimiter,
+                                                            split_options options = split_options::none) {
+        return {str, detail::string_delimiter{delimiter}, options};
+    }
+
+    inline split_range<detail::any_of_delimiter> split_lazy(std::string_view str, any_of delimiters,
+                                                            split_options options = split_options::none) {
+        return {str, detail::any_of_delimiter{delimiters.chars}, options};
+    }
 
     // 将字符串容器通过分隔符连接成一个字符串
     inline std::string join(const std::vector<std::string>& tokens, const std::string& delimiter) {
@@ -283,19 +543,52 @@ namespace strings {
 //        return str;
 //    }
 
+    /**
+     * @brief 按长度做 ASCII 大小写转换, 只修改 A-Z/a-z, 内嵌的 '\0' 不会截断
+     * @details 每次处理一个 SIMD 宽度(SSE2/AVX2/AVX-512 分别为16/32/64字节), 尾部走标量
+     * @param src 输入
+     * @param dst 输出, 可以与 src 相同(原地转换)
+     * @param n 字节数
+     */
+    void to_lower_ascii(const char* src, char* dst, size_t n) noexcept;
+
+    void to_upper_ascii(const char* src, char* dst, size_t n) noexcept;
+
+    // 原地转小写
+    inline void to_lower_inplace(std::string& str) {
+        to_lower_ascii(str.data(), str.data(), str.size());
+    }
+
+    // 原地转大写
+    inline void to_upper_inplace(std::string& str) {
+        to_upper_ascii(str.data(), str.data(), str.size());
+    }
+
+    // 转小写写入 out, 复用 out 已有的容量
+    inline void to_lower_into(std::string_view input, std::string& out) {
+        out.resize(input.size());
+        to_lower_ascii(input.data(), out.data(), input.size());
+    }
+
+    // 转大写写入 out, 复用 out 已有的容量
+    inline void to_upper_into(std::string_view input, std::string& out) {
+        out.resize(input.size());
+        to_upper_ascii(input.data(), out.data(), input.size());
+    }
+
     template <typename T>
     std::enable_if_t<std::is_convertible_v<T, std::string_view>, std::string>
     to_lower(const T& input) {
-        std::string result = input;
-        strtolc_inplace_branchless(result.data());
+        std::string result;
+        to_lower_into(input, result);
         return result;
     }
 
     template <typename T>
     std::enable_if_t<std::is_convertible_v<T, std::string_view>, std::string>
     to_upper(const T& input) {
-        std::string result = input;
-        strtouc_inplace_branchless(result.data());
+        std::string result;
+        to_upper_into(input, result);
         return result;
     }
 
@@ -338,7 +631,12 @@ namespace strings {
      * @return 是否存在匹配的前缀
      */
     inline bool startsWith(const std::string &str, std::initializer_list<std::string> prefixes) {
-        return startsWith(str, std::vector<std::string>(prefixes));
+        for (const auto &prefix: prefixes) {
+            if (str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0) {
+                return true;
+            }
+        }
+        return false;
     }
 
     /**
@@ -356,13 +654,95 @@ namespace strings {
         return false;
     }
 
+    /**
+     * @brief 预编译的多前缀/多后缀匹配器
+     * @details 构造时把模式集合编译成字典树, 节点的转移表按字节类压缩: 只有模式中出现过的字节各占一列,
+     * 其余字节统一映射到第0列(无转移). 查询按输入长度线性推进, 不分配内存, 适合对大量证券代码反复按
+     * 前缀("60", "688", "00", "30" ...)分类. 构造后只读, 可以在多线程间共享.
+     */
+    class affix_matcher {
+    public:
+        enum class mode {
+            prefix,  ///< 匹配前缀
+            suffix,  ///< 匹配后缀
+        };
+
+        static constexpr size_t npos = size_t(-1);
+
+        affix_matcher() = default;
+
+        explicit affix_matcher(std::span<const std::string_view> patterns, mode m = mode::prefix);
+
+        affix_matcher(std::initializer_list<std::string_view> patterns, mode m = mode::prefix)
+            : affix_matcher(std::span<const std::string_view>(patterns.begin(), patterns.size()), m) {}
+
+        explicit affix_matcher(const std::vector<std::string> &patterns, mode m = mode::prefix);
+
+        /**
+         * @brief 查找匹配的最长模式
+         * @return 模式在构造参数中的下标, 重复的模式取第一个; 没有匹配时返回 npos
+         */
+        [[nodiscard]] size_t match(std::string_view str) const noexcept {
+            if (next_.empty()) {
+                return npos;
+            }
+            size_t  best = accept_[0];
+            int32_t node = 0;
+            const size_t n = str.size();
+            for (size_t i = 0; i < n; ++i) {
+                const char c = mode_ == mode::prefix ? str[i] : str[n - 1 - i];
+                node = next_[static_cast<size_t>(node) * stride_ + classes_[static_cast<uint8_t>(c)]];
+                if (node == 0) {
+                    break;
+                }
+                if (accept_[node] != npos) {
+                    best = accept_[node];
+                }
+            }
+            return best;
+        }
+
+        // 是否存在匹配的模式
+        [[nodiscard]] bool matches(std::string_view str) const noexcept {
+            return match(str) != npos;
+        }
+
+        /**
+         * @brief 批量分类, out[i] = match(inputs[i])
+         * @param out 至少 inputs.size() 个元素
+         */
+        void classify(std::span<const std::string_view> inputs, std::span<size_t> out) const noexcept;
+
+        [[nodiscard]] std::vector<size_t> classify(std::span<const std::string_view> inputs) const;
+
+        // 模式个数
+        [[nodiscard]] size_t size() const { return patterns_.size(); }
+
+        [[nodiscard]] const std::string &pattern(size_t index) const { return patterns_[index]; }
+
+    private:
+        mode                        mode_   = mode::prefix;
+        size_t                      stride_ = 1;   // 每个节点的转移表列数, 第0列表示无转移
+        std::array<uint16_t, 256>   classes_{};    // 字节 → 列号
+        std::vector<int32_t>        next_;         // 节点 × 列 → 子节点, 0表示无转移(根不会是子节点)
+        std::vector<size_t>         accept_;       // 节点 → 以该节点结尾的模式下标
+        std::vector<std::string>    patterns_;
+
+        void build(std::span<const std::string_view> patterns);
+    };
+
+    // 去除两端空白和一对双引号, 返回视图, 不分配内存
+    inline std::string_view unquote_view(std::string_view s) {
+        s = trim_view(s);
+        if (s.size() >= 2 && s.front() == '"' && s.back() == '"') {
+            return s.substr(1, s.size() - 2);
+        }
+        return s;
+    }
+
     // 工具函数：去除双引号
     inline std::string remove_quotes(const std::string& s) {
-        std::string processed = trim(s);
-        if (processed.size() >= 2 && processed.front() == '"' && processed.back() == '"') {
-            return processed.substr(1, processed.size() - 2);
-        }
-        return processed;
+        return std::string(unquote_view(s));
     }
 
     // ==============================
@@ -382,18 +762,28 @@ namespace strings {
 //        return false;
 //    }
 
-    //  数值类型的通用实现（int, double, float 等）
+    //  数值类型的通用实现（int, double, float 等）, 数值类型走 from_chars, 其它类型走 istream
     template<typename T>
     //std::enable_if_t<std::is_arithmetic_v<T>, bool>
-    inline bool try_parse(const std::string& str, T& out_value) {
-        std::string processed = remove_quotes(str);
-        std::istringstream iss(processed);
-        T                  value{};
-        if ((iss >> value) && iss.eof()) {
-            out_value = value;
-            return true;
+    inline bool try_parse(std::string_view str, T& out_value) {
+        std::string_view processed = unquote_view(str);
+        if constexpr (detail::is_from_chars_v<T>) {
+            T      value{};
+            size_t used = 0;
+            if (detail::parse_number(processed, value, used) && used == processed.size()) {
+                out_value = value;
+                return true;
+            }
+            return false;
+        } else {
+            std::istringstream iss{std::string(processed)};
+            T                  value{};
+            if ((iss >> value) && iss.eof()) {
+                out_value = value;
+                return true;
+            }
+            return false;
         }
-        return false;
     }
 
 //    // 主模板 - 使用 SFINAE
@@ -411,21 +801,25 @@ namespace strings {
      * @return
      */
     template<>
-    inline bool try_parse<bool>(const std::string& str, bool& out_value) {
-        std::string processed = remove_quotes(str);
-        std::string lower = strtolc_inplace_branchless(processed.data());
-
-        if (lower == "true" || lower == "yes" || lower == "on" || lower == "1") {
-            out_value = true;
-            return true;
-        } else if (lower == "false" || lower == "no" || lower == "off" || lower == "0") {
-            out_value = false;
-            return true;
+    inline bool try_parse<bool>(std::string_view str, bool& out_value) {
+        std::string_view processed = unquote_view(str);
+        // 候选词最长5个字符, 在栈上转小写
+        if (processed.size() <= 5) {
+            char buf[5];
+            to_lower_ascii(processed.data(), buf, processed.size());
+            const std::string_view lower(buf, processed.size());
+            if (lower == "true" || lower == "yes" || lower == "on" || lower == "1") {
+                out_value = true;
+                return true;
+            } else if (lower == "false" || lower == "no" || lower == "off" || lower == "0") {
+                out_value = false;
+                return true;
+            }
         }
 
-        std::istringstream iss(processed);
-        int num = 0;
-        if (iss >> num) {
+        int    num  = 0;
+        size_t used = 0;
+        if (detail::parse_number(processed, num, used)) {
             out_value = num != 0;
             return true;
         }
@@ -435,11 +829,45 @@ namespace strings {
 
     // 特化：std::string
     template<>
-    inline bool try_parse<std::string>(const std::string& str, std::string& out_value) {
+    inline bool try_parse<std::string>(std::string_view str, std::string& out_value) {
         out_value = str;
         return true;
     }
 
+    /**
+     * @brief 批量解析一列 token, 规则与 try_parse 相同
+     * @param tokens 输入, 例如 split_view 的结果
+     * @param out 输出, 只处理与 tokens 等长的部分, 解析失败的位置写入 default_val
+     * @return 解析成功的个数
+     */
+    template <typename T>
+    size_t parse_column(std::span<const std::string_view> tokens, std::span<T> out, T default_val = T{}) {
+        const size_t n  = std::min(tokens.size(), out.size());
+        size_t       ok = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (try_parse(tokens[i], out[i])) {
+                ++ok;
+            } else {
+                out[i] = default_val;
+            }
+        }
+        return ok;
+    }
+
+    template <typename T>
+    std::vector<T> parse_column(std::span<const std::string_view> tokens, T default_val = T{}) {
+        std::vector<T> out;
+        out.reserve(tokens.size());
+        for (const auto& token : tokens) {
+            T value = default_val;
+            if (!try_parse(token, value)) {
+                value = default_val;
+            }
+            out.push_back(value);
+        }
+        return out;
+    }
+
 //    // 特化：std::vector<T>
 //    template<typename T>
 //    inline bool try_parse(const std::string& str, std::vector<T>& out_value) {
@@ -459,6 +887,76 @@ namespace strings {
 //        return true;
 //    }
 
+    // ==============================
+    // 浮点数 → 字符
+    // ==============================
+
+    // format_shortest 输出的最大长度, 如 -2.2250738585072014e-308
+    constexpr size_t float_chars_max = 32;
+
+    /**
+     * @brief 浮点数格式化为最短往返表示, 不依赖 locale
+     * @details Dragonbox 算法(fmt). 用 from_string 解析回来与原值逐位相等; 指数在 [-5, 16) 内时不用科学计数法,
+     * 整数值不带小数点, 如 2.0 输出 "2", 0.1 输出 "0.1"
+     * @param out 至少 float_chars_max 字节, 不追加 '\0'
+     * @return 写入的字节数
+     */
+    size_t format_shortest(double value, char* out) noexcept;
+
+    size_t format_shortest(float value, char* out) noexcept;
+
+    /**
+     * @brief 保留 precision 位小数, 正确舍入, 与 printf("%.*f") 的结果一致, 不依赖 locale
+     * @param out 输出缓冲区, 不追加 '\0'
+     * @param ec precision 为负数时为 invalid_argument, out 不够大时为 value_too_large
+     * @return 写入的字节数, 失败时为0
+     */
+    size_t format_fixed(double value, int precision, std::span<char> out, std::error_code& ec) noexcept;
+
+    /**
+     * @brief 按列批量格式化浮点数, 用于 CSV 等文本导出
+     * @details 一列的值首尾相接写入一块连续缓冲区, 并记录每个值的结束偏移, 不为每个值分配 std::string.
+     * clear 之后保留容量, 分批导出时可以复用
+     */
+    class float_column {
+    public:
+        // precision 小于0时输出最短往返表示, 否则保留 precision 位小数
+        explicit float_column(int precision = -1) noexcept : precision_(precision) {}
+
+        void append(std::span<const double> values);
+
+        void append(std::span<const float> values);
+
+        [[nodiscard]] size_t size() const noexcept { return ends_.size(); }
+
+        [[nodiscard]] int precision() const noexcept { return precision_; }
+
+        // 第 i 个值的文本
+        [[nodiscard]] std::string_view operator[](size_t i) const noexcept {
+            const size_t begin = i == 0 ? 0 : ends_[i - 1];
+            return {chars_.data() + begin, ends_[i] - begin};
+        }
+
+        void clear() noexcept {
+            chars_.clear();
+            ends_.clear();
+        }
+
+    private:
+        int                 precision_;
+        std::string         chars_;
+        std::vector<size_t> ends_;
+
+        template <typename T>
+        void append_values(std::span<const T> values);
+    };
+
+    /**
+     * @brief 按行拼接各列, 追加到 out, 行内以 delimiter 分隔, 每行以 '\n' 结尾
+     * @details 行数取各列长度的最小值
+     */
+    void write_rows(std::span<const float_column> columns, std::string& out, char delimiter = ',');
+
     // ==============================
     // 类型 T → 字符串(std::string)
     // ==============================
@@ -467,11 +965,16 @@ namespace strings {
 //    template <typename T>
 //    std::string to_string(const T& value);
 
-    // 特化：int, double, float 等数值类型
+    // 特化：int, double, float 等数值类型, 浮点数输出最短往返表示
     template <typename T>
     //std::enable_if_t<std::is_arithmetic_v<T>, std::string>
     inline std::string to_string(const T& value) {
-        return std::to_string(value);
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            char buf[float_chars_max];
+            return std::string(buf, format_shortest(value, buf));
+        } else {
+            return std::to_string(value);
+        }
     }
 
     // 特化：bool 类型
@@ -504,22 +1007,84 @@ namespace strings {
         return std::string(value);
     }
 
-    // 特化：std::vector<T>
+    /**
+     * @brief 追加到可复用的缓冲区, 输出与 to_string 一致
+     * @details 整数按 std::to_string 的格式, 浮点数为最短往返表示, 字符串原样追加, vector 输出 [a, b].
+     * 批量转换时复用同一个缓冲区, 避免每个值分配一次 std::string
+     */
     template <typename T>
-    inline std::string to_string(const std::vector<T>& vec) {
-        std::ostringstream oss;
-        oss << "[";
+    void to_string_into(fmt::memory_buffer& out, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            out.append(std::string_view(value ? "true" : "false"));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            out.append(std::string_view(value));
+        } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            char buf[float_chars_max];
+            out.append(buf, buf + format_shortest(value, buf));
+        } else if constexpr (std::is_integral_v<T>) {
+            // 与 std::to_string 一样, char 等窄类型按整数输出
+            fmt::format_to(fmt::appender(out), "{}", +value);
+        } else {
+            fmt::format_to(fmt::appender(out), "{}", value);
+        }
+    }
+
+    template <typename T>
+    void to_string_into(fmt::memory_buffer& out, const std::vector<T>& vec) {
+        out.push_back('[');
         for (size_t i = 0; i < vec.size(); ++i) {
-            oss << to_string(vec[i]);
-            if (i != vec.size() - 1) {
-                oss << ", ";
+            if (i != 0) {
+                out.append(std::string_view(", "));
             }
+            to_string_into(out, vec[i]);
         }
-        oss << "]";
-        return oss.str();
+        out.push_back(']');
     }
 
+    // 特化：std::vector<T>
+    template <typename T>
+    inline std::string to_string(const std::vector<T>& vec) {
+        fmt::memory_buffer buf;
+        to_string_into(buf, vec);
+        return fmt::to_string(buf);
+    }
+
+    // 排序去重, 结果按字典序排列
     std::vector<std::string> unique(std::vector<std::string> arr);
+
+    // 输入规模超过该值时 unique_stable 等函数才会启用多线程
+    constexpr size_t unique_parallel_threshold = 64 * 1024;
+
+    /**
+     * @brief 哈希去重, 保留每个字符串第一次出现的位置和顺序
+     * @param threads 线程数, 0 表示硬件并发数; 输入不足 unique_parallel_threshold 时始终单线程.
+     * 多线程时按哈希值分片, 每个线程只负责自己分片内的字符串, 最后按原顺序收集
+     */
+    std::vector<std::string> unique_stable(const std::vector<std::string>& arr, size_t threads = 1);
+
+    // 原地哈希去重, 保留第一次出现的顺序, 返回删除的个数
+    size_t unique_inplace(std::vector<std::string>& arr, size_t threads = 1);
+
+    // 视图版本, 结果引用输入的字符串
+    std::vector<std::string_view> unique_view(std::span<const std::string_view> arr, size_t threads = 1);
+
+    /**
+     * @brief 十六进制编码, 写入调用方提供的缓冲区
+     * @param bytes 输入字节
+     * @param out 输出, 至少 2 * bytes.size() 字节, 不追加 '\0'
+     * @param uppercase 是否使用大写字母
+     */
+    void hex_encode(std::span<const uint8_t> bytes, char* out, bool uppercase = false) noexcept;
+
+    /**
+     * @brief 十六进制解码, 大小写均可, 不抛出异常
+     * @param hex 十六进制字符串, 长度必须为偶数
+     * @param out 输出, 至少 hex.size() / 2 字节
+     * @param ec 长度为奇数或含非法字符时为 invalid_argument, out 不够大时为 no_buffer_space
+     * @return 成功时为写入的字节数; 遇到非法字符时为该字符所在字节的下标, 之前的字节已写入
+     */
+    size_t hex_decode(std::string_view hex, std::span<uint8_t> out, std::error_code& ec) noexcept;
+
     // 将 string 的每个字节转为十六进制字符串
     std::string to_hex_string(const std::string& input);
 
@@ -527,9 +1092,55 @@ namespace strings {
     std::string bytesToHex(const std::vector<uint8_t>& bytes, bool uppercase = true);
     // 将16进制字符串传承uint8_t数组
     std::vector<uint8_t> hexToBytes(const std::string& hex);
-    // 全部替换
+    // 全部替换, from 为空时原样返回
     std::string replace_all(std::string str, const std::string &from, const std::string &to);
 
+    /**
+     * @brief 多模式替换器, 语义与 Go 的 strings.Replacer 一致
+     * @details 从左到右查找, 匹配之间不重叠; 同一位置有多个模式匹配时, 构造参数中靠前的优先.
+     * 查找先按模式首字节过滤: 不同首字节不超过4个时用 SIMD 比较, 否则查表. 第一遍只计算输出长度,
+     * 第二遍一次性写入结果, 不会像逐个 std::string::replace 那样反复搬移尾部.
+     * 构造后只读, 可以在多线程间共享.
+     */
+    class replacer {
+    public:
+        using pair = std::pair<std::string_view, std::string_view>;
+
+        replacer() = default;
+
+        // 空的 from 被忽略
+        explicit replacer(std::span<const pair> pairs);
+
+        replacer(std::initializer_list<pair> pairs)
+            : replacer(std::span<const pair>(pairs.begin(), pairs.size())) {}
+
+        [[nodiscard]] std::string replace(std::string_view str) const;
+
+        // 结果写入 out(覆盖原内容), 复用 out 的容量; str 不能引用 out 的内容
+        void replace_into(std::string_view str, std::string &out) const;
+
+        // 匹配次数
+        [[nodiscard]] size_t count(std::string_view str) const noexcept;
+
+    private:
+        struct rule {
+            std::string from;
+            std::string to;
+        };
+
+        std::vector<rule>        rules_;
+        std::array<bool, 256>    first_{};        // 模式首字节
+        std::array<uint32_t, 257> bucket_start_{}; // 按首字节分桶, 桶内按优先级排列
+        std::vector<uint32_t>    bucket_;
+        std::array<char, 4>      needles_{};      // 不同首字节不超过4个时用于 SIMD 过滤
+        size_t                   needle_count_ = 0;
+
+        size_t next_candidate(std::string_view str, size_t pos) const noexcept;
+
+        // 从 pos 开始查找下一个匹配, 返回匹配位置, rule 为匹配的规则; 没有时返回 npos
+        size_t next_match(std::string_view str, size_t pos, const rule *&matched) const noexcept;
+    };
+
     // =============================================================================
     // Go 代码移植函数 - 转换为 C++ 实现
     // =============================================================================
@@ -559,12 +1170,16 @@ namespace strings {
     std::string toString(double value);
     std::string toString(bool value);
     
-    // 通用 ToString 模板
+    // 通用 ToString 模板, fmt 能格式化的类型不经过 ostringstream
     template<typename T>
     std::string toString(const T& value) {
-        std::ostringstream oss;
-        oss << value;
-        return oss.str();
+        if constexpr (fmt::is_formattable<T>::value) {
+            return fmt::format("{}", value);
+        } else {
+            std::ostringstream oss;
+            oss << value;
+            return oss.str();
+        }
     }
     
     // CamelCase 转换函数
@@ -580,6 +1195,71 @@ namespace strings {
     std::string kebab_case(const std::string& str);
     std::string upper_kebab_case(const std::string& str);
     
+    // 标识符命名风格
+    enum class identifier_case {
+        upper_camel,  ///< FieldName
+        lower_camel,  ///< fieldName
+        snake,        ///< field_name
+        upper_snake,  ///< FIELD_NAME
+        kebab,        ///< field-name
+        upper_kebab,  ///< FIELD-NAME
+    };
+
+    // 长度为 n 的输入转换命名风格后的最大长度, 每个字符最多带一个分隔符
+    constexpr size_t case_capacity(size_t n) noexcept {
+        return 2 * n;
+    }
+
+    /**
+     * @brief 转换命名风格, 写入调用方提供的缓冲区, 不分配内存
+     * @param out 至少 case_capacity(str.size()) 字节
+     * @return 写入的字节数
+     */
+    size_t convert_case_to(std::string_view str, identifier_case style, char* out) noexcept;
+
+    // 追加到 fmt::memory_buffer
+    template <size_t N>
+    void convert_case_to(std::string_view str, identifier_case style, fmt::basic_memory_buffer<char, N>& out) {
+        const size_t old = out.size();
+        out.resize(old + case_capacity(str.size()));
+        out.resize(old + convert_case_to(str, style, out.data() + old));
+    }
+
+    /**
+     * @brief 带缓存的命名风格转换器
+     * @details 以输入为键缓存转换结果, 反射拷贝等场景中重复出现的字段名只转换一次.
+     * 返回的视图指向缓存, 在转换器销毁或 clear 之前有效. 非线程安全, 每个线程各用一个.
+     */
+    class case_converter {
+    private:
+        struct string_hash {
+            using is_transparent = void;
+            size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+        };
+
+        identifier_case style_;
+        // 节点式容器, 插入新元素不会使已返回的视图失效
+        std::unordered_map<std::string, std::string, string_hash, std::equal_to<>> cache_;
+        std::string buffer_;
+
+    public:
+        explicit case_converter(identifier_case style) : style_(style) {}
+
+        [[nodiscard]] identifier_case style() const { return style_; }
+
+        std::string_view convert(std::string_view name);
+
+        // 批量转换, out 至少 names.size() 个元素
+        void convert(std::span<const std::string_view> names, std::span<std::string_view> out);
+
+        std::vector<std::string_view> convert(std::span<const std::string_view> names);
+
+        // 已缓存的名称个数
+        [[nodiscard]] size_t size() const { return cache_.size(); }
+
+        void clear() { cache_.clear(); }
+    };
+
     // 字符串匹配和判断函数
     bool starts_with(const std::string& str, const std::vector<std::string>& prefixes);
     bool ends_with(const std::string& str, const std::vector<std::string>& suffixes);
@@ -589,7 +1269,15 @@ namespace strings {
     namespace detail {
         std::string camel_case_impl(const std::string& str, bool upper_first);
         std::string delimiter_case_impl(const std::string& str, char delimiter, bool upper_case);
+        // out 至少 str.size() 字节
+        size_t camel_case_to(std::string_view str, bool upper_first, char* out) noexcept;
+        // out 至少 case_capacity(str.size()) 字节
+        size_t delimiter_case_to(std::string_view str, char delimiter, bool upper_case, char* out) noexcept;
     }
 }
 
+// token 只引用源字符串, 不引用视图本身
+template <typename Delimiter>
+inline constexpr bool std::ranges::enable_borrowed_range<strings::split_range<Delimiter>> = true;
+
 #endif //QUANT1X_STD_STRINGS_H
@@ -16,12 +16,14 @@ static_assert(__cpp_lib_chrono >= 201907L, "C++20 <chrono> features not supporte
 #include <fmt/format.h>
 #endif
 
+#include <cstring>
 #include <ctime>
 #include <stdexcept>
 #include <iostream>
 #include "except.h"
 #include "strings.h"
 #include "safe.h"
+#include "buffer.h"
 
 #if CXX_CHRONO_ZONE_USE_DATE
 namespace fmt {
@@ -50,13 +52,247 @@ namespace api {
         return (mktime(&local) - mktime(&utc)) * 1000LL;
     }
 
+    namespace {
+
+        /**
+         * @brief 固定格式的模板, 'd' 表示数字, 其它字符原样匹配
+         * @details 按8字节一块做 SWAR 校验, 块的起点为 0, 7, 14, ..., 最后一块与末尾对齐.
+         * 相邻的块重叠1字节, 这样任意位置开始的两位数都完整地落在某一块里
+         */
+        struct fixed_layout {
+            static constexpr size_t max_chunks = 4;
+
+            size_t   size   = 0;
+            size_t   chunks = 0;
+            size_t   offset[max_chunks]{};
+            uint64_t digit[max_chunks]{};    // 数字位置的字节掩码
+            uint64_t literal[max_chunks]{};  // 分隔符的值
+            uint64_t literal_mask[max_chunks]{};
+
+            constexpr explicit fixed_layout(std::string_view pattern) : size(pattern.size()) {
+                const size_t span = size < 8 ? 8 : size;
+                for (size_t off = 0;; off += 7) {
+                    const size_t start = off + 8 > span ? span - 8 : off;
+                    offset[chunks]     = start;
+                    for (size_t i = 0; i < 8; ++i) {
+                        // 不足8字节的输入在末尾补 '0', 当作数字处理
+                        const char     c    = start + i < size ? pattern[start + i] : 'd';
+                        const uint64_t byte = uint64_t(0xFF) << (8 * i);
+                        if (c == 'd') {
+                            digit[chunks] |= byte;
+                        } else {
+                            literal[chunks] |= uint64_t(static_cast<uint8_t>(c)) << (8 * i);
+                            literal_mask[chunks] |= byte;
+                        }
+                    }
+                    ++chunks;
+                    if (start + 8 >= span) {
+                        break;
+                    }
+                }
+            }
+        };
+
+        // 载入8字节, 第 i 个字符位于第 i 个字节
+        inline uint64_t load8(const char *p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+#if !ENDIAN_LITTLE
+            v = quant1x::detail::byteswap(v);
+#endif
+            return v;
+        }
+
+        inline void store8(uint8_t *p, uint64_t v) noexcept {
+#if !ENDIAN_LITTLE
+            v = quant1x::detail::byteswap(v);
+#endif
+            std::memcpy(p, &v, sizeof(v));
+        }
+
+        /**
+         * @brief 按模板校验, 并算出每个位置开始的两位数
+         * @param pairs 输出, pairs[k] = 第 k 位数字 * 10 + 第 k+1 位数字, 只对模板中连续两位数字的位置有意义
+         */
+        inline bool match_layout(std::string_view str, const fixed_layout &layout, uint8_t *pairs) noexcept {
+            constexpr uint64_t ones = 0x0101010101010101ULL;
+            if (str.size() != layout.size) {
+                return false;
+            }
+            char padded[8] = {'0', '0', '0', '0', '0', '0', '0', '0'};
+            const char *p  = str.data();
+            if (str.size() < 8) {
+                std::memcpy(padded, str.data(), str.size());
+                p = padded;
+            }
+            for (size_t c = 0; c < layout.chunks; ++c) {
+                const uint64_t v     = load8(p + layout.offset[c]);
+                const uint64_t digit = layout.digit[c];
+                if ((v & layout.literal_mask[c]) != layout.literal[c]) {
+                    return false;
+                }
+                // 数字字节的高4位为3, 且低4位加6不进位
+                const uint64_t x    = v & digit;
+                const uint64_t high = digit & (0xF0 * ones);
+                const uint64_t zero = digit & (0x30 * ones);
+                if ((x & high) != zero || ((x + (digit & (0x06 * ones))) & high) != zero) {
+                    return false;
+                }
+                // 分隔符按 '0' 处理, 每字节减去 '0' 后乘10加上后一字节, 不会跨字节进位
+                const uint64_t d = (x | (~digit & (0x30 * ones))) - 0x30 * ones;
+                const uint64_t t = d * 10 + (d >> 8);
+                store8(pairs + layout.offset[c], t);
+            }
+            return true;
+        }
+
+        struct civil_time {
+            int year        = 1970;
+            int month       = 1;
+            int day         = 1;
+            int hour        = 0;
+            int minute      = 0;
+            int second      = 0;
+            int millisecond = 0;
+        };
+
+        // 日期部分
+        void read_date(const uint8_t *pairs, size_t pos, civil_time &t, bool separated) noexcept {
+            const size_t step = separated ? 1 : 0;
+            t.year            = pairs[pos] * 100 + pairs[pos + 2];
+            t.month           = pairs[pos + 4 + step];
+            t.day             = pairs[pos + 6 + 2 * step];
+        }
+
+        // 时间部分, 可以带3位毫秒
+        void read_time(const uint8_t *pairs, size_t pos, civil_time &t, bool separated, bool millis) noexcept {
+            const size_t step = separated ? 1 : 0;
+            t.hour            = pairs[pos];
+            t.minute          = pairs[pos + 2 + step];
+            t.second          = pairs[pos + 4 + 2 * step];
+            if (millis) {
+                t.millisecond = pairs[pos + 7 + 2 * step] * 10 + (pairs[pos + 9 + 2 * step] / 10);
+            }
+        }
+
+        bool valid_time(const civil_time &t) noexcept {
+            return t.hour < 24 && t.minute < 60 && t.second < 60;
+        }
+
+        int64_t time_of_day(const civil_time &t) noexcept {
+            return ((int64_t(t.hour) * 60 + t.minute) * 60 + t.second) * 1000 + t.millisecond;
+        }
+
+        bool to_milliseconds(const civil_time &t, int64_t &ms) noexcept {
+            const std::chrono::year_month_day ymd{std::chrono::year{t.year}, std::chrono::month{unsigned(t.month)},
+                                                  std::chrono::day{unsigned(t.day)}};
+            if (!ymd.ok() || !valid_time(t)) {
+                return false;
+            }
+            const std::chrono::sys_days days{ymd};
+            ms = int64_t(days.time_since_epoch().count()) * 86400000 + time_of_day(t);
+            return true;
+        }
+
+        constexpr fixed_layout fixed_date_time{"dddd-dd-dd dd:dd:dd"};
+        constexpr fixed_layout fixed_date_time_ms{"dddd-dd-dd dd:dd:dd.ddd"};
+        constexpr fixed_layout fixed_date{"dddd-dd-dd"};
+        constexpr fixed_layout fixed_compact_date{"dddddddd"};
+        constexpr fixed_layout fixed_iso{"dddd-dd-ddTdd:dd:ddZ"};
+        constexpr fixed_layout fixed_iso_ms{"dddd-dd-ddTdd:dd:dd.dddZ"};
+        constexpr fixed_layout fixed_time{"dd:dd:dd"};
+        constexpr fixed_layout fixed_time_ms{"dd:dd:dd.ddd"};
+        constexpr fixed_layout fixed_compact_time{"dddddd"};
+
+    }  // namespace
+
+    bool try_parse_date(std::string_view str, int64_t &ms) noexcept {
+        uint8_t    pairs[32];
+        civil_time t;
+        switch (str.size()) {
+            case 8:  // 20230515
+                if (!match_layout(str, fixed_compact_date, pairs)) return false;
+                read_date(pairs, 0, t, false);
+                break;
+            case 10:  // 2023-05-15
+                if (!match_layout(str, fixed_date, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                break;
+            case 19:  // 2023-05-15 14:30:00
+                if (!match_layout(str, fixed_date_time, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                read_time(pairs, 11, t, true, false);
+                break;
+            case 20:  // 2023-05-15T14:30:00Z
+                if (!match_layout(str, fixed_iso, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                read_time(pairs, 11, t, true, false);
+                break;
+            case 23:  // 2023-05-15 14:30:00.123
+                if (!match_layout(str, fixed_date_time_ms, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                read_time(pairs, 11, t, true, true);
+                break;
+            case 24:  // 2023-05-15T14:30:00.123Z
+                if (!match_layout(str, fixed_iso_ms, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                read_time(pairs, 11, t, true, true);
+                break;
+            default:
+                return false;
+        }
+        return to_milliseconds(t, ms);
+    }
+
+    bool try_parse_time(std::string_view str, int64_t &ms) noexcept {
+        uint8_t    pairs[32];
+        civil_time t;
+        switch (str.size()) {
+            case 6:  // 143000
+                if (!match_layout(str, fixed_compact_time, pairs)) return false;
+                read_time(pairs, 0, t, false, false);
+                break;
+            case 8:  // 14:30:00
+                if (!match_layout(str, fixed_time, pairs)) return false;
+                read_time(pairs, 0, t, true, false);
+                break;
+            case 12:  // 14:30:00.123
+                if (!match_layout(str, fixed_time_ms, pairs)) return false;
+                read_time(pairs, 0, t, true, true);
+                break;
+            case 19:  // 2023-05-15 14:30:00, 只取时分秒
+            case 23: {
+                const bool millis = str.size() == 23;
+                if (!match_layout(str, millis ? fixed_date_time_ms : fixed_date_time, pairs)) return false;
+                read_date(pairs, 0, t, true);
+                read_time(pairs, 11, t, true, millis);
+                int64_t unused = 0;
+                if (!to_milliseconds(t, unused)) return false;
+                break;
+            }
+            default:
+                return false;
+        }
+        if (!valid_time(t)) {
+            return false;
+        }
+        ms = time_of_day(t);
+        return true;
+    }
+
     // 解析日期
     int64_t parse_date(const std::string &str) {
-        std::string str_datetime = strings::trim(str);
-        if (str_datetime.empty()) {
+        const std::string_view text = strings::trim_view(str);
+        if (text.empty()) {
             // 空字符串返回0,
             return 0;
         }
+        int64_t ms = 0;
+        if (try_parse_date(text, ms)) {
+            return ms;
+        }
+        // 不是固定格式, 逐个格式尝试
+        std::string str_datetime(text);
         std::chrono::sys_time<std::chrono::milliseconds> tp;
         std::istringstream iss(str_datetime);
         static const auto date_time_layout_supports = {
@@ -92,11 +328,16 @@ namespace api {
 
     // 解析时间
     int64_t parse_time(const std::string &str) {
-        std::string str_time = strings::trim(str);
-        if (str_time.empty()) {
+        const std::string_view text = strings::trim_view(str);
+        if (text.empty()) {
             // 空字符串返回0,
             return 0;
         }
+        int64_t ms = 0;
+        if (try_parse_time(text, ms)) {
+            return ms;
+        }
+        std::string str_time(text);
         std::istringstream iss(str_time);
         // 尝试多种格式 - 既支持纯时间，也支持包含日期的格式
         static const auto only_time_layout_supports = {
@@ -4,6 +4,7 @@
 
 #include "base.h"
 #include <string>
+#include <string_view>
 #include <chrono>
 
 namespace api {
@@ -25,6 +26,15 @@ namespace api {
     /// 设计目的：用户关注时分秒时使用，但不限制输入格式
     int64_t parse_time(const std::string &str);
 
+    /// 固定格式的快速解析, 不分配内存、不抛异常, 输入不能带首尾空白
+    /// 支持格式: "2023-05-15 14:30:00", "2023-05-15", "20230515", "2023-05-15T14:30:00Z", 秒可以带3位毫秒
+    /// 不是这些格式或者日期时间非法时返回 false, parse_date 随后回退到逐个格式尝试
+    bool try_parse_date(std::string_view str, int64_t &ms) noexcept;
+
+    /// 固定格式的快速解析, 返回当天的毫秒数
+    /// 支持格式: "14:30:00", "143000", "2023-05-15 14:30:00"(只取时分秒), 秒可以带3位毫秒
+    bool try_parse_time(std::string_view str, int64_t &ms) noexcept;
+
     int64_t ms_utc_to_local(const int64_t &milliseconds);
 
     int64_t ms_local_to_utc(const int64_t &milliseconds);
@@ -10,6 +10,8 @@
 #include <sstream>
 #include <tuple>
 
+#include "format.h"
+
 namespace quant1x {
 
     constexpr const int64_t seconds_per_minute      = 60;
@@ -149,4 +151,59 @@ namespace quant1x {
 
 } // namespace quant1x
 
+template <>
+struct has_custom_formatter<quant1x::timestamp> : std::true_type {};
+
+/**
+ * @brief timestamp 的 fmt 格式化
+ * @details 不带格式说明时输出 "YYYY-MM-DD HH:MM:SS.mmm", 与 toString() 一致, 直接写数字不经过 chrono 格式化;
+ * 带格式说明时按 chrono 格式处理, 如 {:%Y%m%d}
+ */
+template <>
+struct fmt::formatter<quant1x::timestamp> {
+    std::string_view spec;
+
+    constexpr auto parse(format_parse_context& ctx) {
+        auto it = ctx.begin();
+        while (it != ctx.end() && *it != '}') {
+            ++it;
+        }
+        spec = std::string_view(ctx.begin(), static_cast<size_t>(it - ctx.begin()));
+        return it;
+    }
+
+    auto format(const quant1x::timestamp& ts, format_context& ctx) const {
+        if (!spec.empty()) {
+            const std::string str = ts.toString("{:" + std::string(spec) + "}");
+            return std::copy(str.begin(), str.end(), ctx.out());
+        }
+        namespace chrono = std::chrono;
+        const chrono::sys_time<chrono::milliseconds> tp{chrono::milliseconds{ts.value()}};
+        const auto                                   day = chrono::floor<chrono::days>(tp);
+        const chrono::year_month_day                 ymd{day};
+        const chrono::hh_mm_ss                       hms{tp - day};
+        char                                         buf[24];
+        auto put = [&buf](size_t pos, unsigned value, size_t width) {
+            for (size_t i = width; i > 0; --i) {
+                buf[pos + i - 1] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        };
+        put(0, static_cast<unsigned>(static_cast<int>(ymd.year())), 4);
+        buf[4] = '-';
+        put(5, static_cast<unsigned>(ymd.month()), 2);
+        buf[7] = '-';
+        put(8, static_cast<unsigned>(ymd.day()), 2);
+        buf[10] = ' ';
+        put(11, static_cast<unsigned>(hms.hours().count()), 2);
+        buf[13] = ':';
+        put(14, static_cast<unsigned>(hms.minutes().count()), 2);
+        buf[16] = ':';
+        put(17, static_cast<unsigned>(hms.seconds().count()), 2);
+        buf[19] = '.';
+        put(20, static_cast<unsigned>(hms.subseconds().count()), 3);
+        return std::copy(buf, buf + 23, ctx.out());
+    }
+};
+
 #endif  // QUANT1X_EXCHANGE_TIMESTAMP_H
@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include "../src/buffer.h"
+#include "../src/codec.h"
+
+// Test BinaryStream round trip
+TEST(BinaryStreamTest, RoundTrip) {
+    BinaryStream stream;
+    stream.push_u32(42);
+    stream.push_double(3.14159);
+    stream.push_length_prefixed_string("Hello, World!");
+
+    stream.seek(0);
+    EXPECT_EQ(stream.get_u32(), 42u);
+    EXPECT_DOUBLE_EQ(stream.get_double(), 3.14159);
+    EXPECT_EQ(stream.get_length_prefixed_string(), "Hello, World!");
+    EXPECT_THROW(stream.get_u8(), std::out_of_range);
+}
+
+// Test BinaryStreamView reads the same layout without copying
+TEST(BinaryStreamViewTest, ZeroCopyRead) {
+    BinaryStream stream;
+    stream.push_i16(-7);
+    stream.push_u64(0x0102030405060708ULL);
+    stream.push_float(1.5f);
+    stream.push_length_prefixed_string("sh600000");
+    stream.push_string(std::string("abc\0\0", 5));
+
+    const auto& raw = stream.data();
+    BinaryStreamView view(std::span<const uint8_t>(raw.data(), raw.size()));
+    EXPECT_EQ(view.get_i16(), -7);
+    EXPECT_EQ(view.get_u64(), 0x0102030405060708ULL);
+    EXPECT_FLOAT_EQ(view.get_float(), 1.5f);
+
+    std::string_view code = view.get_length_prefixed_string();
+    EXPECT_EQ(code, "sh600000");
+    // 返回的视图直接指向外部内存
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(code.data()), raw.data());
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(code.data()), raw.data() + raw.size());
+
+    EXPECT_EQ(view.get_string(5), "abc");
+    EXPECT_EQ(view.remaining(), 0u);
+    EXPECT_THROW(view.get_u8(), std::out_of_range);
+}
+
+// Test BinaryStreamView subview and varint
+TEST(BinaryStreamViewTest, SubviewAndVarint) {
+    const uint8_t packet[] = {0x03, 0x00, 0x41, 0x85, 0x01, 0xFF, 0x7F};
+    BinaryStreamView view(packet);
+    EXPECT_EQ(view.get_u16(), 3u);
+
+    BinaryStreamView body = view.subview(3);
+    EXPECT_EQ(body.varint_decode(), -1);
+    EXPECT_EQ(body.varint_decode(), 5 | (1 << 6));
+    EXPECT_EQ(body.remaining(), 0u);
+
+    EXPECT_EQ(view.remaining(), 2u);
+    EXPECT_THROW(view.subview(3), std::out_of_range);
+
+    uint8_t truncated[] = {0x80};
+    BinaryStreamView bad(truncated);
+    EXPECT_THROW(bad.varint_decode(), std::out_of_range);
+}
+
+// Test bulk span push_array/get_array
+TEST(BinaryStreamTest, BulkArray) {
+    std::vector<int32_t> bars(240);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        bars[i] = static_cast<int32_t>(i * 1000) - 50000;
+    }
+    const double prices[3] = {10.01, 10.02, -0.5};
+
+    BinaryStream stream;
+    stream.push_array<int32_t>(bars);
+    stream.push_array(prices);
+    EXPECT_EQ(stream.data().size(), bars.size() * 4 + sizeof(prices));
+    // 逐字节确认为小端序: bars[1] = -49000 = 0xFFFF4098
+    EXPECT_EQ(stream.data()[4], 0x98);
+    EXPECT_EQ(stream.data()[5], 0x40);
+    EXPECT_EQ(stream.data()[7], 0xFF);
+
+    std::vector<int32_t> decoded(240);
+    BinaryStreamView view(stream);
+    view.get_array<int32_t>(decoded);
+    EXPECT_EQ(decoded, bars);
+    auto out = view.get_array<double, 3>();
+    EXPECT_DOUBLE_EQ(out[0], 10.01);
+    EXPECT_DOUBLE_EQ(out[2], -0.5);
+
+    std::vector<int32_t> overflow(1);
+    EXPECT_THROW(view.get_array<int32_t>(overflow), std::out_of_range);
+}
+
+// Test varint codec family
+TEST(VarintTest, RoundTrip) {
+    const int64_t samples[] = {0, 1, -1, 63, -63, 64, -64, 8191, -8192, 1234567, -7654321,
+                               INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN + 1, INT64_MIN};
+    BinaryStream stream;
+    for (int64_t v : samples) {
+        stream.push_varint(v);
+        stream.push_sleb128(v);
+        stream.push_zigzag(v);
+        stream.push_uleb128(static_cast<uint64_t>(v));
+    }
+    stream.seek(0);
+    for (int64_t v : samples) {
+        EXPECT_EQ(stream.varint_decode(), v);
+        EXPECT_EQ(stream.get_sleb128(), v);
+        EXPECT_EQ(stream.get_zigzag(), v);
+        EXPECT_EQ(stream.get_uleb128(), static_cast<uint64_t>(v));
+    }
+    EXPECT_EQ(stream.remaining(), 0u);
+
+    uint8_t buf[quant1x::varint::max_bytes];
+    EXPECT_EQ(quant1x::varint::encode_uleb128(300, buf), 2u);
+    EXPECT_EQ(buf[0], 0xAC);
+    EXPECT_EQ(buf[1], 0x02);
+    EXPECT_EQ(quant1x::varint::zigzag_encode(-1), 1u);
+    EXPECT_EQ(quant1x::varint::zigzag_encode(1), 2u);
+
+    // 超长编码
+    const uint8_t overlong[11] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+    uint64_t out = 0;
+    EXPECT_EQ(quant1x::varint::decode_uleb128(overlong, sizeof(overlong), out), 0u);
+}
+
+// Test batch decode matches scalar decode
+TEST(VarintTest, BatchDecode) {
+    std::vector<int64_t> values;
+    for (int i = 0; i < 5000; ++i) {
+        int64_t v = (i % 7 == 0) ? int64_t(i) * 104729 - 1000000 : (i % 61) - 30;
+        if (i % 997 == 0) {
+            v = INT64_MIN + i;
+        }
+        values.push_back(v);
+    }
+    BinaryStream stream;
+    for (int64_t v : values) {
+        stream.push_varint(v);
+    }
+    const size_t encoded = stream.data().size();
+    stream.push_u32(0xDEADBEEF);
+
+    BinaryStreamView view(stream);
+    std::vector<int64_t> decoded(values.size());
+    view.varint_decode_n(decoded);
+    EXPECT_EQ(decoded, values);
+    EXPECT_EQ(view.position(), encoded);
+    EXPECT_EQ(view.get_u32(), 0xDEADBEEFu);
+
+    view.seek(encoded - 1);
+    std::vector<int64_t> more(3);
+    EXPECT_THROW(view.varint_decode_n(more), std::out_of_range);
+    EXPECT_EQ(view.position(), encoded - 1);
+}
+
+// Test pooled writer mode
+TEST(BinaryStreamWriterTest, PoolReuse) {
+    quant1x::buffer_pool pool(4);
+    const uint8_t* storage = nullptr;
+    for (int round = 0; round < 3; ++round) {
+        BinaryStreamWriter writer(pool, 1024);
+        EXPECT_GE(writer.capacity(), 1024u);
+        if (storage != nullptr) {
+            // 稳态下复用同一块存储
+            EXPECT_EQ(writer.data().data(), storage);
+        }
+        writer.push_u16(0x1234);
+        writer.push_length_prefixed_string("order");
+        writer.push_varint(-100);
+        storage = writer.data().data();
+
+        BinaryStreamView view = writer.view();
+        EXPECT_EQ(view.get_u16(), 0x1234u);
+        EXPECT_EQ(view.get_length_prefixed_string(), "order");
+        EXPECT_EQ(view.varint_decode(), -100);
+    }
+    EXPECT_EQ(pool.cached(), 1u);
+}
+
+// Test writer growth and reserve
+TEST(BinaryStreamWriterTest, Growth) {
+    BinaryStreamWriter writer;
+    writer.reserve(16);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        writer.push_u32(i);
+    }
+    EXPECT_EQ(writer.size(), 40000u);
+    auto taken = writer.take();
+    EXPECT_EQ(taken.size(), 40000u);
+    BinaryStreamView view(taken.data(), taken.size());
+    view.seek(4 * 9999);
+    EXPECT_EQ(view.get_u32(), 9999u);
+
+    BinaryStream stream;
+    stream.reserve(64);
+    stream.push_u64(1);
+    stream.seek(0);
+    stream.push_u32(7);
+    EXPECT_EQ(stream.data().size(), 8u);
+}
+
+namespace {
+    enum class Side : uint8_t { Buy = 1, Sell = 2 };
+
+#pragma pack(push, 1)
+    struct Bar {
+        int32_t date;
+        float   open;
+        float   close;
+        double  volume;
+    };
+#pragma pack(pop)
+
+    struct Level {
+        double  price;
+        int64_t volume;
+    };
+
+    struct Tick {
+        strings::fixed_string<8> code;
+        double                   price;
+    };
+
+    struct Quote {
+        std::string                code;
+        Side                       side;
+        bool                       suspended;
+        std::array<Level, 5>       bids;
+        std::vector<int32_t>       ticks;
+        std::vector<Bar>           bars;
+        std::vector<std::string>   tags;
+        strings::fixed_string<16>  name;
+    };
+}
+
+// Test reflection-driven struct codec
+TEST(CodecTest, StructRoundTrip) {
+    static_assert(quant1x::detail::is_memcpy_layout_v<Bar>);
+    static_assert(quant1x::detail::is_memcpy_layout_v<Level>);
+    static_assert(!quant1x::detail::is_memcpy_layout_v<Quote>);
+    static_assert(quant1x::detail::fixed_wire_size<strings::fixed_string<8>>() == 8);
+    static_assert(quant1x::detail::is_memcpy_layout_v<Tick>);
+
+    Quote q;
+    q.code      = "sh600000";
+    q.side      = Side::Sell;
+    q.suspended = true;
+    for (size_t i = 0; i < q.bids.size(); ++i) {
+        q.bids[i] = {10.0 - 0.01 * double(i), int64_t(100 * (i + 1))};
+    }
+    q.ticks = {1, -2, 3};
+    q.bars  = {{20230515, 10.0f, 10.5f, 1e6}, {20230516, 10.5f, 10.2f, 2e6}};
+    q.tags  = {"bank", "sse50"};
+    q.name  = strings::fixed_string<16>("PFYH");
+
+    BinaryStreamWriter writer;
+    quant1x::encode(writer, q);
+    // code + side + suspended + bids + ticks + bars + tags + name
+    EXPECT_EQ(writer.size(), (4 + 8) + 1 + 1 + 5 * 16 + (4 + 12) + (4 + 2 * sizeof(Bar)) + (4 + 8 + 9) + 16);
+
+    BinaryStreamView view = writer.view();
+    auto d = quant1x::decode<Quote>(view);
+    EXPECT_EQ(view.remaining(), 0u);
+    EXPECT_EQ(d.code, q.code);
+    EXPECT_EQ(d.side, Side::Sell);
+    EXPECT_TRUE(d.suspended);
+    EXPECT_DOUBLE_EQ(d.bids[4].price, q.bids[4].price);
+    EXPECT_EQ(d.bids[4].volume, 500);
+    EXPECT_EQ(d.ticks, q.ticks);
+    ASSERT_EQ(d.bars.size(), 2u);
+    EXPECT_EQ(d.bars[1].date, 20230516);
+    EXPECT_FLOAT_EQ(d.bars[1].close, 10.2f);
+    EXPECT_EQ(d.tags, q.tags);
+    EXPECT_EQ(d.name, "PFYH");
+
+    // 定长字符串字段的结构体整体拷贝
+    const std::vector<Tick> ticks = {{strings::fixed_string<8>("sh600000"), 10.5}, {strings::fixed_string<8>("sz000001"), 12.25}};
+    BinaryStreamWriter tick_writer;
+    quant1x::encode(tick_writer, ticks);
+    EXPECT_EQ(tick_writer.size(), 4 + 2 * 16u);
+    BinaryStreamView tick_view = tick_writer.view();
+    const auto decoded_ticks = quant1x::decode<std::vector<Tick>>(tick_view);
+    ASSERT_EQ(decoded_ticks.size(), 2u);
+    EXPECT_EQ(decoded_ticks[1].code, "sz000001");
+    EXPECT_EQ(decoded_ticks[1].price, 12.25);
+    Tick tick{strings::fixed_string<8>("bj830799"), 1.5};
+    BinaryStream tick_stream;
+    quant1x::encode(tick_stream, tick);
+    tick_stream.seek(0);
+    EXPECT_EQ(tick_stream.get_fixed_string<8>(), "bj830799");
+    EXPECT_EQ(tick_stream.get_double(), 1.5);
+
+    BinaryStream stream;
+    quant1x::encode(stream, q.bars[0]);
+    stream.seek(0);
+    EXPECT_EQ(stream.get_i32(), 20230515);
+    EXPECT_FLOAT_EQ(stream.get_float(), 10.0f);
+}
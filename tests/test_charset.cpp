@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "../src/charset.h"
+
+namespace {
+    // "浦发银行" 的 GBK 编码
+    constexpr std::string_view gbk_name  = "\xC6\xD6\xB7\xA2\xD2\xF8\xD0\xD0";
+    constexpr std::string_view utf8_name = "浦发银行";
+}  // namespace
+
+TEST(CharsetTest, Validate) {
+    EXPECT_TRUE(strings::is_ascii(""));
+    EXPECT_TRUE(strings::is_ascii(std::string(100, 'a')));
+    EXPECT_FALSE(strings::is_ascii(std::string(70, 'a') + "\x80"));
+
+    EXPECT_TRUE(strings::is_utf8(utf8_name));
+    EXPECT_TRUE(strings::is_utf8(std::string(64, 'a') + "\xF0\x9F\x98\x80" + "€"));
+    EXPECT_FALSE(strings::is_utf8("\xC0\xAF"));          // 过长编码
+    EXPECT_FALSE(strings::is_utf8("\xED\xA0\x80"));      // 代理区
+    EXPECT_FALSE(strings::is_utf8("\xF4\x90\x80\x80"));  // 超过 U+10FFFF
+    EXPECT_FALSE(strings::is_utf8("\xE6\xB5"));          // 截断
+    EXPECT_FALSE(strings::is_utf8(gbk_name));
+}
+
+TEST(CharsetTest, Transcode) {
+    // ASCII 与汉字混排, 长度超过 SIMD 宽度
+    std::string gbk  = "sh600000,";
+    std::string utf8 = "sh600000,";
+    for (int i = 0; i < 10; ++i) {
+        gbk += std::string(gbk_name) + "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        utf8 += std::string(utf8_name) + "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    }
+    EXPECT_EQ(strings::gbk_to_utf8(gbk), utf8);
+    EXPECT_EQ(strings::utf8_to_gbk(utf8), gbk);
+
+    std::error_code   ec;
+    std::vector<char> out(strings::gbk_to_utf8_capacity(gbk.size()));
+    size_t            n = strings::gbk_to_utf8(gbk, out, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(std::string_view(out.data(), n), utf8);
+    n = strings::utf8_to_gbk(utf8, out, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(std::string_view(out.data(), n), gbk);
+
+    // 定长字段截断了半个汉字
+    EXPECT_EQ(strings::gbk_to_utf8("ab\xC6\xD6\xB7", out, ec), 4u);
+    EXPECT_EQ(ec, std::errc::illegal_byte_sequence);
+    EXPECT_EQ(strings::gbk_to_utf8("ab\xC6\xD6\xB7"), "ab浦\xEF\xBF\xBD");
+    // GBK 中没有的字符
+    EXPECT_EQ(strings::utf8_to_gbk("a\xF0\x9F\x98\x80", out, ec), 1u);
+    EXPECT_EQ(ec, std::errc::illegal_byte_sequence);
+    EXPECT_EQ(strings::utf8_to_gbk("a\xF0\x9F\x98\x80" "b"), "a?b");
+
+    char small[4];
+    strings::gbk_to_utf8(gbk_name, small, ec);
+    EXPECT_EQ(ec, std::errc::no_buffer_space);
+}
+
+TEST(CharsetTest, Batch) {
+    const std::vector<std::string_view> fields = {gbk_name, "", "ETF\xB5", "\xB9\xA4\xC9\xCC\xD2\xF8\xD0\xD0"};
+    std::vector<std::string_view>       out(fields.size());
+    std::string                         chars = "stale";
+    EXPECT_EQ(strings::gbk_to_utf8(fields, chars, out), 1u);
+    EXPECT_EQ(out[0], utf8_name);
+    EXPECT_EQ(out[1], "");
+    EXPECT_EQ(out[2], "ETF\xEF\xBF\xBD");
+    EXPECT_EQ(out[3], "工商银行");
+    EXPECT_EQ(chars.size(), out[0].size() + out[2].size() + out[3].size());
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "../src/compress.h"
+#include "../src/codec.h"
+
+#include <zlib.h>
+
+using namespace quant1x;
+
+namespace {
+    struct Tick {
+        int64_t  time;
+        double   price;
+        uint32_t volume;
+    };
+
+    std::vector<uint8_t> make_payload(size_t n) {
+        std::vector<uint8_t> data(n);
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = static_cast<uint8_t>((i * 7) % 31 + (i / 1024) % 3);
+        }
+        return data;
+    }
+}
+
+// Test chunked compression interoperates with one-shot zlib
+TEST(CompressTest, DeflaterInflater) {
+    const auto payload = make_payload(200000);
+    deflater d;
+    BinaryStreamWriter compressed;
+    std::error_code ec;
+    // 分块输入同一个流
+    for (size_t pos = 0; pos < payload.size(); pos += 7000) {
+        const size_t n = std::min<size_t>(7000, payload.size() - pos);
+        ASSERT_TRUE(d.compress(std::span<const uint8_t>(payload.data() + pos, n), compressed, false, ec));
+    }
+    ASSERT_TRUE(d.compress({}, compressed, true, ec));
+    EXPECT_LT(compressed.size(), payload.size() / 4);
+
+    std::vector<uint8_t> plain(payload.size());
+    uLongf len = plain.size();
+    ASSERT_EQ(::uncompress(plain.data(), &len, compressed.data().data(), compressed.size()), Z_OK);
+    EXPECT_EQ(plain, payload);
+
+    // 复用同一个解压器解两次
+    inflater inf;
+    for (int round = 0; round < 2; ++round) {
+        BinaryStream out;
+        auto data = compressed.data();
+        for (size_t pos = 0; pos < data.size(); pos += 333) {
+            ASSERT_TRUE(inf.decompress(data.subspan(pos, std::min<size_t>(333, data.size() - pos)), out, ec));
+        }
+        EXPECT_TRUE(inf.finished());
+        EXPECT_EQ(out.data(), payload);
+        inf.reset();
+    }
+
+    std::vector<uint8_t> garbage(100, 0x55);
+    BinaryStream out;
+    EXPECT_FALSE(inf.decompress(garbage, out, ec));
+    EXPECT_EQ(ec.category(), zlib_category());
+}
+
+// Test decoding fields straight from a compressed stream through a small window
+TEST(CompressTest, WriterReaderAdapters) {
+    BinaryStreamWriter sink;
+    deflate_writer writer(sink, 6, zlib_format::gzip, 256);
+    for (int i = 0; i < 10000; ++i) {
+        encode(writer, Tick{1700000000000 + i * 3000, 10.0 + (i % 50) * 0.01, uint32_t(i)});
+        writer.push_varint(i - 5000);
+    }
+    for (int i = 0; i < 3000; ++i) {
+        writer.push_varint(int64_t(i) * i * (i % 2 ? 1 : -1));
+    }
+    writer.push_length_prefixed_string(std::string(1000, 'q'));
+    std::error_code ec;
+    ASSERT_TRUE(writer.finish(ec));
+
+    inflate_reader reader(sink.data(), zlib_format::automatic, 128);
+    for (int i = 0; i < 10000; ++i) {
+        const Tick t = decode<Tick>(reader);
+        ASSERT_EQ(t.time, 1700000000000 + i * 3000);
+        ASSERT_EQ(t.volume, uint32_t(i));
+        ASSERT_EQ(reader.varint_decode(), i - 5000);
+    }
+    std::vector<int64_t> batch(3000);
+    reader.varint_decode_n(batch);
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_EQ(batch[i], int64_t(i) * i * (i % 2 ? 1 : -1));
+    }
+    EXPECT_EQ(reader.get_length_prefixed_string(), std::string(1000, 'q'));
+    EXPECT_TRUE(reader.eof());
+    EXPECT_FALSE(reader.error());
+    EXPECT_THROW(reader.get_u8(), std::out_of_range);
+
+    // 截断的数据
+    reader.reset(sink.data().first(sink.size() / 2));
+    EXPECT_THROW(
+        {
+            for (;;) {
+                decode<Tick>(reader);
+            }
+        },
+        std::out_of_range);
+    EXPECT_TRUE(reader.error());
+}
+
+// Test corrupt length prefixes fail without allocating the claimed size
+TEST(CompressTest, ReaderCorruptLength) {
+    // 声称有 0xFFFFFFF0 个元素, 实际只有几个字节
+    BinaryStreamWriter sink;
+    deflate_writer writer(sink);
+    writer.push_u32(0xFFFFFFF0u);
+    writer.push_u32(1);
+    writer.push_u32(2);
+    std::error_code ec;
+    ASSERT_TRUE(writer.finish(ec));
+
+    inflate_reader reader(sink.data());
+    EXPECT_THROW(decode<std::vector<uint32_t>>(reader), std::out_of_range);
+    EXPECT_EQ(reader.error(), std::errc::value_too_large);
+
+    // 长度在上限之内, 但数据不足
+    inflate_reader limited(sink.data(), zlib_format::automatic, 64, size_t(1) << 32);
+    EXPECT_THROW(decode<std::vector<uint32_t>>(limited), std::out_of_range);
+    EXPECT_FALSE(limited.error());
+
+    // 截断的压缩数据
+    limited.reset(sink.data().first(sink.size() - 6));
+    EXPECT_THROW(decode<std::vector<uint32_t>>(limited), std::out_of_range);
+    EXPECT_TRUE(limited.error());
+
+    // 长度前缀的字符串
+    BinaryStreamWriter text;
+    deflate_writer text_writer(text);
+    text_writer.push_u32(0x7FFFFFFFu);
+    text_writer.push_string("abc");
+    ASSERT_TRUE(text_writer.finish(ec));
+    inflate_reader text_reader(text.data());
+    EXPECT_THROW(text_reader.get_length_prefixed_string(), std::out_of_range);
+    EXPECT_EQ(text_reader.error(), std::errc::value_too_large);
+}
+
+// Test multi-threaded block compression round trip
+TEST(CompressTest, Blocks) {
+    std::vector<std::vector<uint8_t>> inputs;
+    std::vector<std::span<const uint8_t>> blocks;
+    for (size_t i = 0; i < 37; ++i) {
+        inputs.push_back(make_payload(1000 + i * 977));
+    }
+    for (const auto& in : inputs) {
+        blocks.emplace_back(in);
+    }
+    std::error_code ec;
+    auto compressed = compress_blocks(blocks, ec, 6, zlib_format::zlib, 4);
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(compressed.size(), inputs.size());
+
+    std::vector<std::span<const uint8_t>> packed(compressed.begin(), compressed.end());
+    auto plain = decompress_blocks(packed, ec, zlib_format::zlib, 3);
+    ASSERT_FALSE(ec);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_TRUE(std::equal(plain[i].begin(), plain[i].end(), inputs[i].begin(), inputs[i].end())) << i;
+    }
+
+    packed[5] = packed[5].first(packed[5].size() - 3);
+    plain = decompress_blocks(packed, ec);
+    EXPECT_TRUE(ec);
+    EXPECT_TRUE(plain.empty());
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "../src/frame.h"
+
+#include <numeric>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace quant1x;
+
+#if !defined(_WIN32)
+// 从fd读取n个字节
+static std::vector<uint8_t> read_exact(int fd, size_t n) {
+    std::vector<uint8_t> out(n);
+    size_t got = 0;
+    while (got < n) {
+        ssize_t r = ::read(fd, out.data() + got, n - got);
+        if (r <= 0) {
+            break;
+        }
+        got += size_t(r);
+    }
+    out.resize(got);
+    return out;
+}
+
+#endif
+
+// Test frame layout matches BinaryStream encoding
+TEST(FrameBuilderTest, Layout) {
+    std::vector<uint8_t> payload(4096);
+    std::iota(payload.begin(), payload.end(), uint8_t(0));
+
+    frame_builder frame;
+    frame.push_u16(0x0C01);
+    frame.push_u32(7);
+    frame.push_length_prefixed_ref(std::span<const uint8_t>(payload));
+    frame.push_bytes(std::span<const uint8_t>(payload.data(), 16));
+    frame.push_u8(0xFF);
+    // 头部, 引用负载, 尾部(小负载与后续字段合并为一个内联段)
+    EXPECT_EQ(frame.segment_count(), 3u);
+
+    BinaryStream expect;
+    expect.push_u16(0x0C01);
+    expect.push_u32(7);
+    expect.push_length_prefixed_string(std::string(payload.begin(), payload.end()));
+    expect.push_byte_array(payload.data(), 16);
+    expect.push_u8(0xFF);
+    EXPECT_EQ(frame.size(), expect.data().size());
+    EXPECT_EQ(frame.to_bytes(), expect.data());
+
+    frame.clear();
+    EXPECT_EQ(frame.size(), 0u);
+    EXPECT_EQ(frame.segment_count(), 0u);
+}
+
+#if !defined(_WIN32)
+// Test writev and sendmsg output
+TEST(FrameBuilderTest, WriteAndSend) {
+    std::string big(1 << 20, 'x');
+    frame_builder frame;
+    frame.push_u32(static_cast<uint32_t>(big.size()));
+    frame.push_ref(big);
+    frame.push_string("END");
+
+    int sv[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    std::vector<uint8_t> received;
+    std::thread reader([&] { received = read_exact(sv[1], frame.size()); });
+    std::error_code ec;
+    EXPECT_EQ(frame.send_to(sv[0], ec), frame.size());
+    EXPECT_FALSE(ec);
+    reader.join();
+    EXPECT_EQ(received, frame.to_bytes());
+
+    std::thread reader2([&] { received = read_exact(sv[1], frame.size()); });
+    EXPECT_EQ(frame.write_to(sv[0], ec), frame.size());
+    EXPECT_FALSE(ec);
+    reader2.join();
+    EXPECT_EQ(received, frame.to_bytes());
+    ::close(sv[0]);
+    ::close(sv[1]);
+
+    EXPECT_EQ(frame.write_to(-1, ec), 0u);
+    EXPECT_TRUE(ec);
+}
+
+// Test resuming writes on a non-blocking socket after EAGAIN
+TEST(FrameBuilderTest, ResumeAfterWouldBlock) {
+    std::string big(4 << 20, 'y');
+    frame_builder frame;
+    frame.push_u32(static_cast<uint32_t>(big.size()));
+    frame.push_ref(big);
+    frame.push_string("END");
+
+    int sv[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    ASSERT_EQ(::fcntl(sv[0], F_SETFL, ::fcntl(sv[0], F_GETFL) | O_NONBLOCK), 0);
+
+    // 对端还没有读, 发送缓冲区写满后返回已写出的位置
+    std::error_code ec;
+    size_t pos = frame.send_to(sv[0], ec);
+    ASSERT_TRUE(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block);
+    ASSERT_GT(pos, 0u);
+    ASSERT_LT(pos, frame.size());
+
+    std::vector<uint8_t> received;
+    std::thread reader([&] { received = read_exact(sv[1], frame.size()); });
+    bool use_send = false;
+    while (pos < frame.size()) {
+        struct pollfd pfd {sv[0], POLLOUT, 0};
+        ASSERT_EQ(::poll(&pfd, 1, 5000), 1);
+        pos = use_send ? frame.send_to(sv[0], ec, pos) : frame.write_to(sv[0], ec, pos);
+        ASSERT_TRUE(!ec || ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block);
+        use_send = !use_send;
+    }
+    EXPECT_EQ(pos, frame.size());
+    reader.join();
+    EXPECT_EQ(received, frame.to_bytes());
+    ::close(sv[0]);
+    ::close(sv[1]);
+}
+#endif
+
+// Test decoding frames split at every possible chunk size
+TEST(FrameDecoderTest, ArbitraryChunks) {
+    BinaryStream stream;
+    std::vector<std::string> expect;
+    for (int i = 0; i < 50; ++i) {
+        expect.push_back(std::string(size_t(i * 7 % 37), char('a' + i % 26)));
+        stream.push_length_prefixed_string(expect.back());
+    }
+    const auto& bytes = stream.data();
+    for (size_t chunk = 1; chunk <= bytes.size(); chunk += 5) {
+        frame_decoder decoder;
+        std::vector<std::string> got;
+        size_t zero_copy = 0;
+        for (size_t pos = 0; pos < bytes.size(); pos += chunk) {
+            const size_t n = std::min(chunk, bytes.size() - pos);
+            const uint8_t* base = bytes.data() + pos;
+            auto status = decoder.feed(std::span<const uint8_t>(base, n), [&](const frame_view& f) {
+                if (f.header.data() >= base && f.header.data() < base + n) {
+                    ++zero_copy;
+                }
+                got.emplace_back(f.reader().get_string(f.payload.size()));
+            });
+            ASSERT_EQ(status, frame_status::ok);
+        }
+        EXPECT_EQ(got, expect);
+        EXPECT_EQ(decoder.buffered(), 0u);
+        if (chunk >= bytes.size()) {
+            EXPECT_EQ(zero_copy, expect.size());
+        }
+    }
+}
+
+// Test custom header format and error states
+TEST(FrameDecoderTest, HeaderFormat) {
+    // 6字节头: 2字节魔数 + 偏移2处的u16大端长度(包含帧头) + 2字节保留
+    frame_format format;
+    format.length_offset     = 2;
+    format.length_size       = 2;
+    format.header_size       = 6;
+    format.big_endian        = true;
+    format.length_adjustment = -6;
+    format.max_frame_size    = 64;
+    frame_decoder decoder(format);
+
+    const uint8_t data[] = {0xAB, 0xCD, 0x00, 0x09, 0x00, 0x00, 'x', 'y', 'z'};
+    std::string payload;
+    auto on_frame = [&](const frame_view& f) { payload.assign(f.payload.begin(), f.payload.end()); };
+    EXPECT_EQ(decoder.feed(std::span<const uint8_t>(data, 3), on_frame), frame_status::ok);
+    EXPECT_EQ(decoder.buffered(), 3u);
+    EXPECT_EQ(decoder.feed(std::span<const uint8_t>(data + 3, 6), on_frame), frame_status::ok);
+    EXPECT_EQ(payload, "xyz");
+
+    const uint8_t big[] = {0xAB, 0xCD, 0x01, 0x00, 0x00, 0x00};
+    EXPECT_EQ(decoder.feed(std::span<const uint8_t>(big), on_frame), frame_status::frame_too_large);
+    EXPECT_EQ(decoder.feed(std::span<const uint8_t>(data), on_frame), frame_status::frame_too_large);
+    decoder.reset();
+    const uint8_t small[] = {0xAB, 0xCD, 0x00, 0x02, 0x00, 0x00};
+    EXPECT_EQ(decoder.feed(std::span<const uint8_t>(small), on_frame), frame_status::malformed);
+
+    frame_format bad;
+    bad.length_size = 9;
+    EXPECT_EQ(frame_decoder(bad).status(), frame_status::malformed);
+}
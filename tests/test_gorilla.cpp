@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../src/gorilla.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace quant1x;
+
+// Test bit writer/reader at arbitrary widths
+TEST(BitStreamTest, RoundTrip) {
+    BinaryStreamWriter w;
+    bit_writer bits(w);
+    for (unsigned n = 0; n <= 64; ++n) {
+        bits.write(0xA5A5A5A5A5A5A5A5ull, n);
+        bits.write_bit(n & 1);
+    }
+    bits.flush();
+
+    bit_reader r(w.data());
+    for (unsigned n = 0; n <= 64; ++n) {
+        const uint64_t mask = n == 64 ? ~0ull : (1ull << n) - 1;
+        EXPECT_EQ(r.read(n), 0xA5A5A5A5A5A5A5A5ull & mask) << n;
+        EXPECT_EQ(r.read_bit(), bool(n & 1));
+    }
+    EXPECT_LT(r.remaining(), 8u);
+    EXPECT_THROW(r.read(8), std::out_of_range);
+}
+
+// Test tick series round trip and compression ratio
+TEST(GorillaTest, RoundTrip) {
+    std::vector<int64_t> timestamps;
+    std::vector<double>  values;
+    int64_t ts    = 1700000000000;
+    double  price = 12.34;
+    for (int i = 0; i < 5000; ++i) {
+        ts += (i % 97 == 0) ? 3000 + i % 7 : 3000;
+        if (i % 5 == 0) {
+            price += (i % 3 == 0 ? 0.01 : -0.01);
+        }
+        timestamps.push_back(ts);
+        values.push_back(price);
+    }
+    timestamps.push_back(ts - 100000);
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    timestamps.push_back(std::numeric_limits<int64_t>::max());
+    values.push_back(-0.0);
+
+    gorilla_encoder encoder;
+    encoder.append(timestamps, values);
+    EXPECT_EQ(encoder.size(), timestamps.size());
+
+    BinaryStream stream;
+    stream.push_u32(0xDEADBEEF);
+    encoder.finish(stream);
+    stream.push_u32(0xCAFEBABE);
+    EXPECT_LT(stream.data().size() * 5, timestamps.size() * 16);
+
+    stream.seek(0);
+    EXPECT_EQ(stream.get_u32(), 0xDEADBEEFu);
+    gorilla_decoder decoder(stream);
+    EXPECT_EQ(stream.get_u32(), 0xCAFEBABEu);
+    std::vector<int64_t> ts_out;
+    std::vector<double>  v_out;
+    decoder.decode(ts_out, v_out);
+    ASSERT_EQ(ts_out, timestamps);
+    ASSERT_EQ(v_out.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(std::bit_cast<uint64_t>(v_out[i]), std::bit_cast<uint64_t>(values[i])) << i;
+    }
+    EXPECT_EQ(decoder.remaining(), 0u);
+
+    // 逐个读取
+    BinaryStreamView view(stream.data());
+    view.skip(4);
+    gorilla_decoder one(view);
+    int64_t t;
+    double  v;
+    ASSERT_TRUE(one.next(t, v));
+    EXPECT_EQ(t, timestamps[0]);
+    EXPECT_EQ(v, values[0]);
+    std::vector<double> rest;
+    one.decode(rest);
+    EXPECT_EQ(rest.size(), values.size() - 1);
+    EXPECT_FALSE(one.next(t, v));
+
+    encoder.clear();
+    EXPECT_EQ(encoder.size(), 0u);
+    encoder.append(1, 1.5);
+    BinaryStream empty;
+    encoder.finish(empty);
+    empty.seek(0);
+    gorilla_decoder single(empty);
+    ASSERT_TRUE(single.next(t, v));
+    EXPECT_EQ(t, 1);
+    EXPECT_EQ(v, 1.5);
+}
+
+// Test truncated input
+TEST(GorillaTest, Truncated) {
+    gorilla_encoder encoder;
+    for (int i = 0; i < 100; ++i) {
+        encoder.append(i * 1000, i * 0.5);
+    }
+    BinaryStream stream;
+    encoder.finish(stream);
+    const auto& bytes = stream.data();
+    BinaryStreamView view(bytes.data(), bytes.size() - 1);
+    EXPECT_THROW(gorilla_decoder{view}, std::out_of_range);
+}
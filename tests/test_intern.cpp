@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "../src/intern.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace quant1x;
+
+TEST(StringPoolTest, InternAndView) {
+    string_pool pool(4);
+    const uint32_t a = pool.intern("sh600000");
+    const uint32_t b = pool.intern("sz000001");
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 1u);
+    EXPECT_EQ(pool.intern(std::string("sh600000")), a);
+    EXPECT_EQ(pool.find("sz000001"), b);
+    EXPECT_EQ(pool.find("bj830799"), string_pool::npos);
+    EXPECT_EQ(pool.intern(""), 2u);
+    EXPECT_EQ(pool.view(2), "");
+    EXPECT_EQ(pool.view(100), "");
+
+    // 跨越多个段和多次扩容后, 早先返回的视图依然有效
+    const std::string_view first = pool.view(a);
+    const std::string big(40000, 'x');
+    for (int i = 0; i < 5000; ++i) {
+        pool.intern("field_" + std::to_string(i));
+    }
+    pool.intern(big);
+    EXPECT_EQ(first, "sh600000");
+    EXPECT_EQ(first.data(), pool.view(a).data());
+    EXPECT_EQ(pool.size(), 5004u);
+    for (int i = 0; i < 5000; i += 97) {
+        const std::string name = "field_" + std::to_string(i);
+        EXPECT_EQ(pool.view(pool.find(name)), name);
+    }
+    EXPECT_EQ(pool.view(pool.find(big)), big);
+}
+
+TEST(StringPoolTest, Concurrent) {
+    string_pool pool(16);
+    constexpr int threads = 4;
+    constexpr int names   = 2000;
+    std::vector<std::vector<uint32_t>> ids(threads, std::vector<uint32_t>(names));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < names; ++i) {
+                // 各线程以不同顺序驻留同一批字符串
+                const int k = (i * 7 + t * 131) % names;
+                ids[t][k] = pool.intern("name" + std::to_string(k));
+                EXPECT_EQ(pool.view(ids[t][k]), "name" + std::to_string(k));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(pool.size(), size_t(names));
+    for (int t = 1; t < threads; ++t) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+}
+
+TEST(StringPoolTest, SnapshotRestore) {
+    const std::string path = (std::filesystem::temp_directory_path() / "quant1x_string_pool.bin").string();
+    {
+        string_pool pool;
+        for (int i = 0; i < 300; ++i) {
+            pool.intern("code" + std::to_string(i * 13));
+        }
+        std::error_code ec;
+        ASSERT_TRUE(pool.save(path, ec)) << ec.message();
+    }
+    string_pool restored;
+    std::error_code ec;
+    ASSERT_TRUE(restored.load(path, ec)) << ec.message();
+    EXPECT_EQ(restored.size(), 300u);
+    EXPECT_EQ(restored.find("code13"), 1u);
+    EXPECT_EQ(restored.view(299), "code3887");
+
+    EXPECT_FALSE(restored.load(path, ec));
+    EXPECT_EQ(ec, std::errc::operation_not_permitted);
+    string_pool missing;
+    EXPECT_FALSE(missing.load(path + ".missing", ec));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(intern("global"), intern("global"));
+    EXPECT_EQ(interned(intern("global")), "global");
+}
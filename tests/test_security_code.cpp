@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../src/security_code.h"
+
+#include <map>
+#include <unordered_map>
+
+using namespace quant1x;
+
+TEST(SecurityCodeTest, Basic) {
+    constexpr security_code code = "sh600000";
+    static_assert(code.valid());
+    static_assert(code.market() == market::sh);
+    static_assert(code.board() == board::main);
+    static_assert(sizeof(security_code) == sizeof(uint64_t));
+
+    EXPECT_EQ(code.to_string(), "sh600000");
+    char symbol[6];
+    EXPECT_EQ(std::string_view(symbol, code.symbol(symbol)), "600000");
+    EXPECT_EQ(security_code::parse("SH600000"), code);
+    EXPECT_TRUE(code.starts_with("sh60"));
+    EXPECT_FALSE(code.starts_with("sz"));
+
+    EXPECT_EQ(security_code::parse("sh688981").board(), board::star);
+    EXPECT_EQ(security_code::parse("sz300750").board(), board::chinext);
+    EXPECT_EQ(security_code::parse("sz000001").board(), board::main);
+    EXPECT_EQ(security_code::parse("sz399001").board(), board::index);
+    EXPECT_EQ(security_code::parse("sh510050").board(), board::fund);
+    EXPECT_EQ(security_code::parse("bj830799").market(), market::bj);
+
+    EXPECT_FALSE(security_code::parse("600000"));
+    EXPECT_FALSE(security_code::parse("sh60000a"));
+    EXPECT_FALSE(security_code::parse("hk600000"));
+    EXPECT_FALSE(security_code::parse("sh60000/"));
+    EXPECT_FALSE(security_code::parse("sh60000:"));
+    EXPECT_FALSE(security_code{});
+
+    // 整数序与字典序一致
+    EXPECT_LT(security_code::parse("sh600000"), security_code::parse("sh600001"));
+    EXPECT_LT(security_code::parse("bj830799"), security_code::parse("sh000001"));
+
+    std::unordered_map<security_code, int> prices;
+    prices[code] = 1;
+    prices[security_code::parse("sz000001")] = 2;
+    EXPECT_EQ(prices.at(security_code::parse("sh600000")), 1);
+    std::map<security_code, int> sorted(prices.begin(), prices.end());
+    EXPECT_EQ(sorted.begin()->first.to_string(), "sh600000");
+}
+
+TEST(SecurityCodeTest, Batch) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 600; ++i) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%s%06d", i % 3 == 0 ? "sh" : (i % 3 == 1 ? "SZ" : "bj"), i * 1117);
+        storage.emplace_back(buf);
+    }
+    storage[5]   = "sz12345";
+    storage[77]  = "xx000001";
+    storage[300] = "sh00000x";
+    std::vector<std::string_view> views(storage.begin(), storage.end());
+    std::vector<security_code> codes(views.size());
+    EXPECT_EQ(parse_security_codes(views, codes), views.size() - 3);
+    for (size_t i = 0; i < views.size(); ++i) {
+        EXPECT_EQ(codes[i], security_code::parse(views[i])) << views[i];
+    }
+    EXPECT_FALSE(codes[5]);
+    EXPECT_EQ(codes[1].to_string(), "sz001117");
+
+    std::string raw;
+    for (const auto& s : storage) {
+        raw += s.size() == 8 ? s : std::string("sz12345 ");
+    }
+    std::unique_ptr<bool[]> valid(new bool[storage.size()]);
+    EXPECT_EQ(validate_security_codes(raw, std::span<bool>(valid.get(), storage.size())), storage.size() - 3);
+    EXPECT_TRUE(valid[0]);
+    EXPECT_FALSE(valid[5]);
+    EXPECT_FALSE(valid[77]);
+    EXPECT_FALSE(valid[300]);
+}
@@ -0,0 +1,435 @@
+#include <gtest/gtest.h>
+#include "../src/strings.h"
+#include "../src/buffer.h"
+
+// Test split_view matches split and points into the source
+TEST(StringsTest, SplitView) {
+    std::string line = " 600000 ,浦发银行,  10.25,,\t1234567 , ";
+    for (int i = 0; i < 5; ++i) {
+        line += line;  // 跨越多个 SIMD 块
+    }
+    for (bool ignore : {false, true}) {
+        const auto expect = strings::split(line, ',', ignore);
+        const auto views  = strings::split_view(line, ',', ignore);
+        ASSERT_EQ(views.size(), expect.size());
+        for (size_t i = 0; i < views.size(); ++i) {
+            EXPECT_EQ(views[i], expect[i]);
+            EXPECT_TRUE(views[i].empty() || (views[i].data() >= line.data() && views[i].data() < line.data() + line.size()));
+        }
+    }
+
+    std::vector<std::string_view> reuse;
+    EXPECT_EQ(strings::split_view("a;b;;c", ';', reuse), 4u);
+    EXPECT_EQ(reuse[3], "c");
+    EXPECT_EQ(strings::split_view("a;b;;c", ';', reuse, true), 3u);
+    EXPECT_EQ(reuse.size(), 3u);
+
+    std::string_view fixed[2];
+    EXPECT_EQ(strings::split_view(" x | y | z ", '|', std::span<std::string_view>(fixed)), 3u);
+    EXPECT_EQ(fixed[0], "x");
+    EXPECT_EQ(fixed[1], "y");
+
+    EXPECT_TRUE(strings::split_view("", ',').empty());
+    EXPECT_EQ(strings::split_view("abc", ',').size(), 1u);
+}
+
+// Test lazy split range and composition with std::views
+TEST(StringsTest, SplitLazy) {
+    static_assert(std::ranges::forward_range<strings::split_range<strings::detail::char_delimiter>>);
+    static_assert(std::ranges::view<strings::split_range<strings::detail::char_delimiter>>);
+
+    std::string line;
+    for (int i = 0; i < 50; ++i) {
+        line += "f" + std::to_string(i) + (i + 1 < 50 ? "," : "");
+    }
+    auto third = strings::split_lazy(line, ',') | std::views::drop(2) | std::views::take(1);
+    ASSERT_FALSE(std::ranges::empty(third));
+    EXPECT_EQ(*third.begin(), "f2");
+
+    std::vector<std::string_view> tokens;
+    for (auto token : strings::split_lazy(" a , b ,, c ", ',', strings::split_options::trim | strings::split_options::skip_empty)) {
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(tokens, (std::vector<std::string_view>{"a", "b", "c"}));
+
+    auto raw = strings::split_lazy("a::b::", "::");
+    EXPECT_EQ(std::ranges::distance(raw), 3);
+    EXPECT_EQ(std::ranges::distance(strings::split_lazy("a b\tc", strings::any_of{" \t"})), 3);
+    EXPECT_EQ(std::ranges::distance(strings::split_lazy("", ',')), 0);
+    EXPECT_EQ(std::ranges::distance(strings::split_lazy("abc", "")), 1);
+
+    auto upper = strings::split_lazy("x|y", '|') | std::views::transform([](std::string_view t) { return std::string(t) + "!"; });
+    EXPECT_EQ(*std::ranges::next(upper.begin()), "y!");
+}
+
+// Test length-aware case conversion
+TEST(StringsTest, CaseConversion) {
+    std::string mixed;
+    for (int i = 0; i < 300; ++i) {
+        mixed.push_back(static_cast<char>(i & 0xFF));
+    }
+    std::string lower;
+    strings::to_lower_into(mixed, lower);
+    std::string upper = strings::to_upper(mixed);
+    ASSERT_EQ(lower.size(), mixed.size());
+    for (size_t i = 0; i < mixed.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(mixed[i]);
+        EXPECT_EQ(static_cast<unsigned char>(lower[i]), (c >= 'A' && c <= 'Z') ? c + 32 : c) << i;
+        EXPECT_EQ(static_cast<unsigned char>(upper[i]), (c >= 'a' && c <= 'z') ? c - 32 : c) << i;
+    }
+
+    // 内嵌的 '\0' 不截断
+    std::string symbol("SH600000\0SZ000001", 17);
+    EXPECT_EQ(strings::to_lower(symbol), std::string("sh600000\0sz000001", 17));
+    strings::to_upper_inplace(symbol);
+    EXPECT_EQ(symbol, std::string("SH600000\0SZ000001", 17));
+
+    std::string reused;
+    reused.reserve(64);
+    const auto* data = reused.data();
+    strings::to_upper_into(std::string_view("sz000001"), reused);
+    EXPECT_EQ(reused, "SZ000001");
+    EXPECT_EQ(reused.data(), data);
+}
+
+// Test from_chars based parsing keeps try_parse/from_string semantics
+TEST(StringsTest, ParseNumbers) {
+    int i = -1;
+    EXPECT_TRUE(strings::try_parse(std::string(" \"42\" "), i));
+    EXPECT_EQ(i, 42);
+    EXPECT_TRUE(strings::try_parse("+7", i));
+    EXPECT_EQ(i, 7);
+    EXPECT_FALSE(strings::try_parse("12abc", i));
+    EXPECT_EQ(i, 7);
+    EXPECT_FALSE(strings::try_parse("", i));
+    EXPECT_FALSE(strings::try_parse("99999999999", i));
+    EXPECT_FALSE(strings::try_parse("+-1", i));
+
+    double d = 0;
+    EXPECT_TRUE(strings::try_parse("3.25", d));
+    EXPECT_EQ(d, 3.25);
+    EXPECT_TRUE(strings::try_parse("-1e-3", d));
+    EXPECT_DOUBLE_EQ(d, -0.001);
+    // 与 istream 一样不接受 inf/nan
+    for (const char* text : {"inf", "-inf", "infinity", "nan", "NaN", "+nan"}) {
+        EXPECT_FALSE(strings::try_parse(text, d)) << text;
+    }
+    EXPECT_DOUBLE_EQ(d, -0.001);
+    EXPECT_EQ(strings::from_string<double>("nan", 1.0), 1.0);
+    float f = 0;
+    EXPECT_FALSE(strings::try_parse("inf", f));
+
+    // 与 istream 一样, 无符号类型的负数按模回绕
+    unsigned u = 0;
+    EXPECT_TRUE(strings::try_parse("-5", u));
+    EXPECT_EQ(u, 4294967291u);
+    EXPECT_TRUE(strings::try_parse("-0", u));
+    EXPECT_EQ(u, 0u);
+    EXPECT_FALSE(strings::try_parse("-4294967296", u));
+    EXPECT_FALSE(strings::try_parse("--5", u));
+    EXPECT_EQ(strings::from_string<uint64_t>("-1"), UINT64_MAX);
+
+    bool b = false;
+    EXPECT_TRUE(strings::try_parse("\"YES\"", b));
+    EXPECT_TRUE(b);
+    EXPECT_TRUE(strings::try_parse("Off", b));
+    EXPECT_FALSE(b);
+    EXPECT_TRUE(strings::try_parse("2", b));
+    EXPECT_TRUE(b);
+    EXPECT_FALSE(strings::try_parse("maybe", b));
+
+    std::string str;
+    EXPECT_TRUE(strings::try_parse(" raw ", str));
+    EXPECT_EQ(str, " raw ");
+
+    EXPECT_EQ(strings::from_string<int>(" 12abc"), 12);
+    EXPECT_EQ(strings::from_string<int>("abc", -1), -1);
+    EXPECT_EQ(strings::from_string<double>("1.5"), 1.5);
+    EXPECT_EQ(strings::from_string<char>("xyz"), 'x');
+
+    const std::string line = "1.5, 2, bad, 4e2";
+    const auto tokens = strings::split_view(line, ',');
+    std::vector<double> column(tokens.size());
+    EXPECT_EQ(strings::parse_column<double>(tokens, column, -1.0), 3u);
+    EXPECT_EQ(column, (std::vector<double>{1.5, 2, -1, 400}));
+    EXPECT_EQ(strings::parse_column<int>(tokens, 0), (std::vector<int>{0, 2, 0, 0}));
+}
+
+TEST(StringsTest, HexEncodeDecode) {
+    std::vector<uint8_t> bytes(300);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    // 覆盖 SIMD 主循环和标量尾部
+    for (size_t n : {0u, 1u, 15u, 16u, 33u, 64u, 300u}) {
+        std::span<const uint8_t> part(bytes.data(), n);
+        std::string expected;
+        for (uint8_t b : part) {
+            expected.push_back("0123456789abcdef"[b >> 4]);
+            expected.push_back("0123456789abcdef"[b & 0x0F]);
+        }
+        std::string hex(2 * n, '\0');
+        strings::hex_encode(part, hex.data());
+        EXPECT_EQ(hex, expected);
+
+        std::vector<uint8_t> decoded(n);
+        std::error_code ec;
+        EXPECT_EQ(strings::hex_decode(strings::to_upper(hex), decoded, ec), n);
+        EXPECT_FALSE(ec);
+        EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), part.begin()));
+    }
+
+    EXPECT_EQ(strings::to_hex_string("\x01\xAB"), "01ab");
+    EXPECT_EQ(strings::bytesToHex({0x0F, 0xF0}), "0FF0");
+    EXPECT_EQ(strings::hexToBytes("0fF0"), (std::vector<uint8_t>{0x0F, 0xF0}));
+    EXPECT_THROW(strings::hexToBytes("abc"), std::invalid_argument);
+    EXPECT_THROW(strings::hexToBytes("zz"), std::invalid_argument);
+
+    // 非法字符: 返回所在字节的下标, 不抛异常
+    std::string bad(80, 'a');
+    bad[50] = 'g';
+    std::vector<uint8_t> out(40);
+    std::error_code ec;
+    EXPECT_EQ(strings::hex_decode(bad, out, ec), 25u);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    bad[50] = '/';
+    bad[51] = ':';
+    EXPECT_EQ(strings::hex_decode(bad, out, ec), 25u);
+    EXPECT_EQ(strings::hex_decode("abc", out, ec), 0u);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    EXPECT_EQ(strings::hex_decode("abcd", std::span<uint8_t>(out.data(), 1), ec), 0u);
+    EXPECT_EQ(ec, std::errc::no_buffer_space);
+}
+
+TEST(StringsTest, AffixMatcher) {
+    const strings::affix_matcher prefixes({"60", "688", "00", "30", "6"});
+    EXPECT_EQ(prefixes.match("600000"), 0u);
+    EXPECT_EQ(prefixes.match("688981"), 1u);
+    EXPECT_EQ(prefixes.match("000001"), 2u);
+    EXPECT_EQ(prefixes.match("300750"), 3u);
+    EXPECT_EQ(prefixes.match("689009"), 4u);
+    EXPECT_EQ(prefixes.match("830799"), strings::affix_matcher::npos);
+    EXPECT_EQ(prefixes.match(""), strings::affix_matcher::npos);
+    EXPECT_EQ(prefixes.match("3"), strings::affix_matcher::npos);
+    EXPECT_TRUE(prefixes.matches("68"));
+    EXPECT_EQ(prefixes.pattern(1), "688");
+
+    const std::vector<std::string> markets = {".SH", ".SZ", ".BJ"};
+    const strings::affix_matcher suffixes(markets, strings::affix_matcher::mode::suffix);
+    const std::vector<std::string_view> codes = {"600000.SH", "000001.SZ", "830799.BJ", "AAPL", "SH"};
+    EXPECT_EQ(suffixes.classify(codes),
+              (std::vector<size_t>{0, 1, 2, strings::affix_matcher::npos, strings::affix_matcher::npos}));
+
+    const strings::affix_matcher empty;
+    EXPECT_FALSE(empty.matches("600000"));
+    const strings::affix_matcher any({""});
+    EXPECT_EQ(any.match("x"), 0u);
+
+    EXPECT_TRUE(strings::startsWith("600000", {"00", "60"}));
+    EXPECT_FALSE(strings::starts_with("600000", markets));
+    EXPECT_TRUE(strings::ends_with("600000.SH", markets));
+}
+
+TEST(StringsTest, Replacer) {
+    EXPECT_EQ(strings::replace_all("a.b.c", ".", "::"), "a::b::c");
+    EXPECT_EQ(strings::replace_all("aaaa", "aa", "a"), "aa");
+    EXPECT_EQ(strings::replace_all("abc", "", "x"), "abc");
+    EXPECT_EQ(strings::replace_all("abc", "b", ""), "ac");
+
+    // 靠前的规则优先, 匹配不重叠
+    const strings::replacer html({{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}, {"\"", "&quot;"}});
+    EXPECT_EQ(html.replace("<a href=\"x\">&</a>"), "&lt;a href=&quot;x&quot;&gt;&amp;&lt;/a&gt;");
+    EXPECT_EQ(html.count("<<>>"), 4u);
+
+    const strings::replacer priority({{"a", "1"}, {"aaa", "3"}, {"aa", "2"}, {"", "x"}});
+    EXPECT_EQ(priority.replace("aaaa"), "1111");
+    const strings::replacer longer({{"aaa", "3"}, {"a", "1"}});
+    EXPECT_EQ(longer.replace("aaaa"), "31");
+
+    // 超过4个不同首字节时走查表路径, 长输入覆盖 SIMD 主循环
+    const strings::replacer vars({{"${a}", "A"}, {"${bb}", "BB"}, {"#", "##"}, {"%", ""}, {"@", "at"}, {"!", "."}});
+    std::string input, expected;
+    for (int i = 0; i < 50; ++i) {
+        input += "x ${a} y ${bb} #%@! ${c} ";
+        expected += "x A y BB ##at. ${c} ";
+    }
+    EXPECT_EQ(vars.replace(input), expected);
+
+    const strings::replacer sep({{",", ";"}});
+    std::string out = "stale";
+    sep.replace_into(std::string(100, ','), out);
+    EXPECT_EQ(out, std::string(100, ';'));
+    EXPECT_EQ(strings::replacer().replace("keep"), "keep");
+}
+
+TEST(StringsTest, IdentifierCase) {
+    using strings::identifier_case;
+    char buf[64];
+    const std::string_view name = "myHTTPServer2Go";
+    ASSERT_LE(strings::case_capacity(name.size()), sizeof(buf));
+    EXPECT_EQ(std::string_view(buf, strings::convert_case_to(name, identifier_case::snake, buf)), "my_http_server2go");
+    EXPECT_EQ(std::string_view(buf, strings::convert_case_to(" foo-bar baz ", identifier_case::lower_camel, buf)), "fooBarBaz");
+    EXPECT_EQ(std::string_view(buf, strings::convert_case_to("userID", identifier_case::upper_kebab, buf)), "USER-ID");
+    EXPECT_EQ(strings::convert_case_to("", identifier_case::snake, buf), 0u);
+
+    fmt::memory_buffer out;
+    strings::convert_case_to("HelloWorld", identifier_case::snake, out);
+    out.push_back(',');
+    strings::convert_case_to("hello_world", identifier_case::upper_camel, out);
+    EXPECT_EQ(fmt::to_string(out), "hello_world,HelloWorld");
+
+    EXPECT_EQ(strings::snake_case("JSONData"), "json_data");
+    EXPECT_EQ(strings::upper_camel_case("x-Y-z"), "XYZ");
+
+    strings::case_converter converter(identifier_case::snake);
+    const std::vector<std::string_view> fields = {"OpenPrice", "ClosePrice", "OpenPrice", "Volume"};
+    const auto converted = converter.convert(fields);
+    EXPECT_EQ(converted, (std::vector<std::string_view>{"open_price", "close_price", "open_price", "volume"}));
+    EXPECT_EQ(converter.size(), 3u);
+    // 同一个输入返回同一份缓存
+    EXPECT_EQ(converted[0].data(), converted[2].data());
+    for (int i = 0; i < 100; ++i) {
+        converter.convert("Field" + std::to_string(i));
+    }
+    EXPECT_EQ(converted[1], "close_price");
+}
+
+TEST(StringsTest, FixedString) {
+    using name_t = strings::fixed_string<8>;
+    static_assert(std::is_trivially_copyable_v<name_t>);
+    static_assert(sizeof(name_t) == 8);
+    constexpr name_t code("sh600000");
+    static_assert(code.size() == 8);
+    static_assert(code == std::string_view("sh600000"));
+
+    // 截断语义与 strings::from 一致
+    const char raw[8] = {'a', 'b', 'c', '\0', 'x', 'y', 'z', 'w'};
+    const auto field = name_t::from_bytes(raw);
+    EXPECT_EQ(field.view(), strings::from(raw));
+    EXPECT_EQ(field.size(), 3u);
+    EXPECT_EQ(name_t("too long for eight"), "too long");
+    EXPECT_TRUE(name_t().empty());
+    EXPECT_EQ(field, name_t("abc"));
+    EXPECT_LT(name_t("abc"), name_t("abd"));
+    EXPECT_EQ(std::hash<name_t>{}(field), std::hash<std::string_view>{}("abc"));
+    EXPECT_EQ(fmt::format("[{:>5}]", field), "[  abc]");
+
+    BinaryStreamWriter w;
+    w.push_fixed_string(code);
+    w.push_fixed_string(field);
+    BinaryStreamView r(w.data());
+    EXPECT_EQ(r.get_fixed_string<8>(), code);
+    name_t back;
+    r.get_fixed_string(back);
+    EXPECT_EQ(std::memcmp(back.data(), raw, sizeof(raw)), 0);
+}
+
+TEST(StringsTest, Unique) {
+    const std::vector<std::string> small = {"b", "a", "b", "c", "a", ""};
+    EXPECT_EQ(strings::unique(small), (std::vector<std::string>{"", "a", "b", "c"}));
+    EXPECT_EQ(strings::unique_stable(small), (std::vector<std::string>{"b", "a", "c", ""}));
+    std::vector<std::string> inplace = small;
+    EXPECT_EQ(strings::unique_inplace(inplace), 2u);
+    EXPECT_EQ(inplace, (std::vector<std::string>{"b", "a", "c", ""}));
+    const std::vector<std::string_view> views(small.begin(), small.end());
+    const auto unique_views = strings::unique_view(views);
+    ASSERT_EQ(unique_views.size(), 4u);
+    EXPECT_EQ(unique_views[0].data(), small[0].data());
+
+    // 超过阈值时走多线程分片, 结果与单线程一致
+    std::vector<std::string> large;
+    for (size_t i = 0; i < strings::unique_parallel_threshold * 2; ++i) {
+        large.push_back("code_with_a_long_prefix_" + std::to_string((i * 7919) % 50000));
+    }
+    const auto serial = strings::unique_stable(large, 1);
+    EXPECT_EQ(serial.size(), 50000u);
+    EXPECT_EQ(strings::unique_stable(large, 4), serial);
+    std::vector<std::string> large_inplace = large;
+    EXPECT_EQ(strings::unique_inplace(large_inplace, 3), large.size() - 50000);
+    EXPECT_EQ(large_inplace, serial);
+}
+
+namespace {
+    struct named {
+        std::string name;
+        [[nodiscard]] std::string toString() const { return "<" + name + ">"; }
+    };
+}  // namespace
+
+TEST(StringsTest, Format) {
+    // 带字符串方法的类型
+    EXPECT_EQ(fmt::format("{}", named{"a"}), "<a>");
+    EXPECT_EQ(fmt::format("{:>5}", named{"a"}), "  <a>");
+    EXPECT_EQ(fmt::format("{}", std::vector<named>{{"a"}, {"b"}}), "[<a>, <b>]");
+    // vector 与 operator<< 的输出一致, 字符串不加引号
+    const std::vector<std::string> words = {"x", "y"};
+    std::ostringstream oss;
+    oss << words;
+    EXPECT_EQ(fmt::format("{}", words), oss.str());
+    EXPECT_EQ(fmt::format("{}", std::vector<std::vector<int>>{{1}, {2, 3}}), "[[1], [2, 3]]");
+
+    // to_string 的输出保持不变
+    EXPECT_EQ(strings::to_string(std::vector<double>{1.5, 2}), "[1.5, 2]");
+    EXPECT_EQ(strings::to_string(std::vector<bool>{true, false}), "[true, false]");
+    EXPECT_EQ(strings::to_string(std::vector<std::string>{"a", "b"}), "[a, b]");
+    fmt::memory_buffer buf;
+    strings::to_string_into(buf, std::vector<int>{1, 2});
+    buf.push_back(';');
+    strings::to_string_into(buf, 'a');
+    EXPECT_EQ(fmt::to_string(buf), "[1, 2];97");
+    EXPECT_EQ(strings::toString(named{"n"}), "<n>");
+    EXPECT_EQ(strings::toString(words), "[x, y]");
+}
+
+TEST(StringsTest, FloatFormat) {
+    char buf[strings::float_chars_max];
+    auto shortest = [&buf](auto value) { return std::string(buf, strings::format_shortest(value, buf)); };
+    EXPECT_EQ(shortest(0.1), "0.1");
+    EXPECT_EQ(shortest(2.0), "2");
+    EXPECT_EQ(shortest(100000.0), "100000");
+    EXPECT_EQ(shortest(-12.345), "-12.345");
+    EXPECT_EQ(shortest(3.14f), "3.14");
+    EXPECT_EQ(shortest(1e20), "1e+20");
+    EXPECT_EQ(shortest(-std::numeric_limits<double>::max()), "-1.7976931348623157e+308");
+    EXPECT_EQ(shortest(std::numeric_limits<double>::denorm_min()), "5e-324");
+    // 往返
+    for (const double v : {0.1 + 0.2, 1.0 / 3, 123456.789, 9.87654321e-7, 6.02214076e23}) {
+        EXPECT_EQ(strings::from_string<double>(shortest(v)), v);
+    }
+    EXPECT_EQ(strings::toString(0.5), "0.5");
+    EXPECT_EQ(strings::to_string(10.25), "10.25");
+
+    std::error_code ec;
+    auto fixed = [&buf, &ec](double value, int precision) {
+        return std::string(buf, strings::format_fixed(value, precision, buf, ec));
+    };
+    EXPECT_EQ(fixed(10.125, 2), "10.12");  // 10.125 可精确表示, 舍入到偶数
+    EXPECT_EQ(fixed(1.005, 2), "1.00");    // 实际值略小于 1.005
+    EXPECT_EQ(fixed(-0.5, 0), "-0");
+    EXPECT_EQ(fixed(3.0, 3), "3.000");
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(fixed(1e300, 2), "");
+    EXPECT_EQ(ec, std::errc::value_too_large);
+    fixed(1.0, -1);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+
+    // 按列格式化后按行拼接
+    const std::vector<double> prices = {10.5, 9.875, 1e300};
+    const std::vector<float>  ratios = {0.25f, 1.5f, 3.0f};
+    std::vector<strings::float_column> columns;
+    columns.emplace_back(2);
+    columns.emplace_back();
+    columns[0].append(prices);
+    columns[1].append(ratios);
+    ASSERT_EQ(columns[0].size(), 3u);
+    EXPECT_EQ(columns[0][1], "9.88");
+    EXPECT_EQ(columns[0][2].size(), 304u);
+    std::string csv;
+    strings::write_rows(std::span<const strings::float_column>(columns.data(), 2), csv);
+    EXPECT_EQ(csv.substr(0, 20), "10.50,0.25\n9.88,1.5\n");
+    columns[0].clear();
+    columns[0].append(std::vector<double>{1.0});
+    csv.clear();
+    strings::write_rows(columns, csv, '\t');
+    EXPECT_EQ(csv, "1.00\t0.25\n");
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../src/timestamp.h"
+#include "../src/time.h"
 
 using namespace quant1x;
 
@@ -70,6 +71,46 @@ TEST_F(TimestampTest, StringFormatting) {
     EXPECT_EQ(yyyymmdd, 20220615);
 }
 
+// Test fixed-layout fast path
+TEST_F(TimestampTest, FixedLayoutParsing) {
+    int64_t ms = 0;
+    EXPECT_TRUE(api::try_parse_date("2023-05-15 14:30:00", ms));
+    EXPECT_EQ(ms, 1684161000000);
+    EXPECT_TRUE(api::try_parse_date("2023-05-15 14:30:00.123", ms));
+    EXPECT_EQ(ms, 1684161000123);
+    EXPECT_TRUE(api::try_parse_date("2023-05-15T14:30:00Z", ms));
+    EXPECT_EQ(ms, 1684161000000);
+    EXPECT_TRUE(api::try_parse_date("20230515", ms));
+    EXPECT_EQ(ms, 1684108800000);
+    EXPECT_TRUE(api::try_parse_date("2024-02-29", ms));
+    EXPECT_FALSE(api::try_parse_date("2023-02-29", ms));
+    EXPECT_FALSE(api::try_parse_date("2023-05-15 24:00:00", ms));
+    EXPECT_FALSE(api::try_parse_date("2023/05/15 14:30:00", ms));
+
+    EXPECT_TRUE(api::try_parse_time("14:30:00.123", ms));
+    EXPECT_EQ(ms, 52200123);
+    EXPECT_TRUE(api::try_parse_time("143000", ms));
+    EXPECT_EQ(ms, 52200000);
+    EXPECT_TRUE(api::try_parse_time("2023-05-15 23:59:59", ms));
+    EXPECT_EQ(ms, 86399000);
+    EXPECT_FALSE(api::try_parse_time("240000", ms));
+
+    // 快速路径与逐个格式尝试的结果一致, 其它格式仍然可以解析
+    EXPECT_EQ(timestamp::parse(" 2023-05-15 14:30:00 ").value(), 1684161000000);
+    EXPECT_EQ(timestamp("2023-05-15").value(), 1684108800000);
+    EXPECT_EQ(timestamp::parse("2023/05/15 14:30:00").value(), 1684161000000);
+    EXPECT_EQ(timestamp::parse_time("14:30:00").value(), 52200000);
+}
+
+// Test fmt formatter
+TEST_F(TimestampTest, FmtFormatter) {
+    timestamp ts(2022, 6, 15, 14, 30, 45, 123);
+    EXPECT_EQ(fmt::format("{}", ts), "2022-06-15 14:30:45.123");
+    EXPECT_EQ(fmt::format("{}", ts), ts.toString());
+    EXPECT_EQ(fmt::format("{:%Y%m%d}", ts), "20220615");
+    EXPECT_EQ(fmt::format("{}", timestamp(0)), "1970-01-01 00:00:00.000");
+}
+
 // Test time operations
 TEST_F(TimestampTest, TimeOperations) {
     timestamp ts(2022, 6, 15, 14, 30, 45, 123);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include "../src/buffer.h"
+
+#include <random>
+
+// 模拟日线文件中的价格差: 绝大多数为小幅变动, 少量跳空
+static std::vector<uint8_t> make_price_deltas(size_t count) {
+    std::mt19937_64 rng(20230515);
+    std::uniform_int_distribution<int> small(-60, 60);
+    std::uniform_int_distribution<int> large(-500000, 500000);
+    BinaryStream stream;
+    for (size_t i = 0; i < count; ++i) {
+        stream.push_varint(i % 16 == 0 ? large(rng) : small(rng));
+    }
+    return stream.data();
+}
+
+constexpr size_t kValues = 1 << 16;
+
+static void BM_VarintDecodeLoop(benchmark::State& state) {
+    const auto data = make_price_deltas(kValues);
+    std::vector<int64_t> out(kValues);
+    for (auto _ : state) {
+        BinaryStreamView view(data);
+        for (auto& v : out) {
+            v = view.varint_decode();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(kValues));
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+BENCHMARK(BM_VarintDecodeLoop);
+
+static void BM_VarintDecodeBatch(benchmark::State& state) {
+    const auto data = make_price_deltas(kValues);
+    std::vector<int64_t> out(kValues);
+    for (auto _ : state) {
+        BinaryStreamView view(data);
+        view.varint_decode_n(out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(kValues));
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+BENCHMARK(BM_VarintDecodeBatch);
+
+static void BM_VarintEncode(benchmark::State& state) {
+    std::vector<int64_t> values(kValues);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> small(-60, 60);
+    for (auto& v : values) {
+        v = small(rng);
+    }
+    BinaryStream stream;
+    for (auto _ : state) {
+        stream.clear();
+        for (int64_t v : values) {
+            stream.push_varint(v);
+        }
+        benchmark::DoNotOptimize(stream.data().data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(kValues));
+}
+BENCHMARK(BM_VarintEncode);